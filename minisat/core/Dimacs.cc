@@ -0,0 +1,97 @@
+/***************************************************************************************[Dimacs.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <thread>
+
+#include "minisat/core/Dimacs.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Parallel DIMACS reading:
+
+
+// Reads one chunk. Chunks end directly after a newline (or at the end of the text), so only the
+// whitespace skipping needs to check the bound: numbers and comment lines never cross it.
+static void readChunk(const char* in, const char* end, DimacsChunk& chunk)
+{
+    vec<int>& lits = chunk.lits;
+    lits.capacity((int)((end - in) / 4) + 1);
+
+    for (;;){
+        while (in < end && ((*in >= 9 && *in <= 13) || *in == 32))
+            ++in;
+        if (in == end || *in == '\0')
+            break;
+
+        if (*in == 'c' || *in == 'p'){
+            while (*in != '\n' && *in != '\0')
+                ++in;
+            continue; }
+
+        int  val = 0;
+        bool neg = false;
+        if      (*in == '-') neg = true, ++in;
+        else if (*in == '+') ++in;
+        if (*in < '0' || *in > '9') fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+        while (*in >= '0' && *in <= '9')
+            val = val*10 + (*in - '0'),
+            ++in;
+
+        if (val == 0)
+            chunk.clauses++;
+        else if (val > chunk.max_var)
+            chunk.max_var = val;
+        lits.push(neg ? -val : val);
+    }
+}
+
+
+void Minisat::readDimacsChunks(const char* begin, const char* end, int n_threads, vec<DimacsChunk*>& chunks)
+{
+    if (n_threads <= 0)
+        n_threads = (int)std::thread::hardware_concurrency();
+    if (n_threads <= 0)
+        n_threads = 1;
+
+    // Split at the first newline after each equally sized piece:
+    vec<const char*> bounds;
+    bounds.push(begin);
+    for (int i = 1; i < n_threads; i++){
+        const char* b = begin + (end - begin) / n_threads * i;
+        if (b < bounds.last()) b = bounds.last();
+        while (b < end && *b != '\n') b++;
+        if (b < end) b++;
+        bounds.push(b);
+    }
+    bounds.push(end);
+
+    int first = chunks.size();
+    for (int i = 0; i < n_threads; i++)
+        chunks.push(new DimacsChunk());
+
+    vec<std::thread*> threads;
+    for (int i = 1; i < n_threads; i++)
+        threads.push(new std::thread(readChunk, bounds[i], bounds[i+1], std::ref(*chunks[first+i])));
+    readChunk(bounds[0], bounds[1], *chunks[first]);
+    for (int i = 0; i < threads.size(); i++){
+        threads[i]->join();
+        delete threads[i]; }
+}
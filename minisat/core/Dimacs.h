@@ -52,11 +52,12 @@ static void parse_DIMACS_main(B& in, Solver& S, bool strictp = false) {
     int cnt     = 0;
     for (;;){
         skipWhitespace(in);
-        if (*in == EOF) break;
+        if (isEof(in)) break;
         else if (*in == 'p'){
             if (eagerMatch(in, "p cnf")){
                 vars    = parseInt(in);
                 clauses = parseInt(in);
+                S.reserve(vars, clauses, 0);
                 // SATRACE'06 hack
                 // if (clauses > 4000000)
                 //     S.eliminate(true);
@@ -74,6 +75,74 @@ static void parse_DIMACS_main(B& in, Solver& S, bool strictp = false) {
         printf("PARSE ERROR! DIMACS header mismatch: wrong number of clauses\n");
 }
 
+//=================================================================================================
+// Parallel DIMACS Parser:
+//
+// The clause section of an in-memory DIMACS text is split at line boundaries into chunks that are
+// read on separate threads. Each chunk stores the literals found in it in file order, with every
+// clause terminated by 0 (a clause may continue in the next chunk). The clauses are then added to
+// the solver in their original order, after pre-allocating the solver for the whole problem.
+
+struct DimacsChunk {
+    vec<int> lits;
+    int      max_var;
+    int      clauses;     // Number of clause terminators in 'lits'.
+    DimacsChunk() : max_var(0), clauses(0) {}
+};
+
+// Reads the clauses in '[begin, end)' into (at most) 'n_threads' chunks (0 means one per hardware
+// thread). The chunks are appended to 'chunks' and must be deleted by the caller:
+void readDimacsChunks(const char* begin, const char* end, int n_threads, vec<DimacsChunk*>& chunks);
+
+template<class Solver>
+static void parse_DIMACS_parallel(const char* in, const char* end, Solver& S, int n_threads, bool strictp = false) {
+    int vars    = 0;
+    int clauses = 0;
+    for (;;){
+        skipWhitespace(in);
+        if (*in == 'c')
+            skipLine(in);
+        else if (*in == 'p'){
+            if (eagerMatch(in, "p cnf")){
+                vars    = parseInt(in);
+                clauses = parseInt(in);
+            }else{
+                printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            }
+        }else
+            break;
+    }
+
+    vec<DimacsChunk*> chunks;
+    readDimacsChunks(in, end, n_threads, chunks);
+
+    int      n_vars = 0, n_clauses = 0;
+    uint64_t n_lits = 0;
+    for (int i = 0; i < chunks.size(); i++){
+        n_vars     = n_vars > chunks[i]->max_var ? n_vars : chunks[i]->max_var;
+        n_clauses += chunks[i]->clauses;
+        n_lits    += chunks[i]->lits.size() - chunks[i]->clauses; }
+    S.reserve(n_vars, n_clauses, n_lits);
+
+    vec<Lit> lits;
+    for (int i = 0; i < chunks.size(); i++){
+        const vec<int>& ls = chunks[i]->lits;
+        while (S.nVars() < chunks[i]->max_var) S.newVar();
+        for (int j = 0; j < ls.size(); j++)
+            if (ls[j] == 0){
+                S.addClause_(lits);
+                lits.clear();
+            }else
+                lits.push( (ls[j] > 0) ? mkLit(ls[j]-1) : ~mkLit(-ls[j]-1) );
+        delete chunks[i];
+    }
+    if (lits.size() > 0)
+        fprintf(stderr, "PARSE ERROR! Unexpected end of file\n"), exit(3);
+    if (strictp && n_clauses != clauses)
+        printf("PARSE ERROR! DIMACS header mismatch: wrong number of clauses\n");
+}
+
+//=================================================================================================
 // Inserts problem into solver.
 //
 template<class Solver>
@@ -81,6 +150,119 @@ static void parse_DIMACS(gzFile input_stream, Solver& S, bool strictp = false) {
     StreamBuffer in(input_stream);
     parse_DIMACS_main(in, S, strictp); }
 
+// Inserts the problem in 'file' into solver ('NULL' reads standard input). Uncompressed files are
+// memory mapped and parsed in place, using 'n_threads' threads unless it is 1 (0 means one per
+// hardware thread). Everything else is read through zlib. Returns false if the file could not be
+// opened.
+//
+template<class Solver>
+static bool parse_DIMACS(const char* file, Solver& S, bool strictp = false, int n_threads = 1) {
+    MappedFile mf;
+    if (file != NULL && mf.open(file)){
+        const char* in = mf.begin();
+        if (n_threads == 1)
+            parse_DIMACS_main(in, S, strictp);
+        else
+            parse_DIMACS_parallel(in, in + mf.bytes(), S, n_threads, strictp);
+        return true; }
+
+    gzFile in = (file == NULL) ? gzdopen(0, "rb") : gzopen(file, "rb");
+    if (in == NULL)
+        return false;
+    parse_DIMACS(in, S, strictp);
+    gzclose(in);
+    return true; }
+
+//=================================================================================================
+// OPB Parser:
+//
+// Reads linear pseudo-Boolean problems in the OPB format of the PB competitions. A constraint is a
+// sum of terms 'coefficient literal', a relation ('>=', '=' or '<=') and a bound, ended by ';'. The
+// literals are 'x<n>' or '~x<n>', and lines starting with '*' are comments. The terms of the
+// objective function ('min: ... ;'), if any, are returned. Non-linear terms are not supported.
+
+template<class B, class Solver>
+static void readTerms(B& in, Solver& S, vec<Lit>& lits, vec<int64_t>& coefs) {
+    lits.clear();
+    coefs.clear();
+    for (;;){
+        skipWhitespace(in);
+        if (isEof(in)) fprintf(stderr, "PARSE ERROR! Unexpected end of file\n"), exit(3);
+        if (*in == ';' || *in == '>' || *in == '<' || *in == '=') break;
+        int64_t coef = parseInt64(in);
+        skipWhitespace(in);
+        bool neg = *in == '~';
+        if (neg) ++in;
+        if (*in != 'x') fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+        ++in;
+        int var = parseInt(in) - 1;
+        if (var < 0) fprintf(stderr, "PARSE ERROR! Bad variable: x%d\n", var + 1), exit(3);
+        while (var >= S.nVars()) S.newVar();
+        lits .push(mkLit(var, neg));
+        coefs.push(coef);
+        skipWhitespace(in);
+        if (*in == 'x' || *in == '~') fprintf(stderr, "PARSE ERROR! Non-linear terms are not supported\n"), exit(3);
+    }
+}
+
+template<class B, class Solver>
+static void parse_OPB_main(B& in, Solver& S, vec<Lit>& obj_lits, vec<int64_t>& obj_coefs) {
+    vec<Lit>     lits;
+    vec<int64_t> coefs;
+    obj_lits .clear();
+    obj_coefs.clear();
+    for (;;){
+        skipWhitespace(in);
+        if (isEof(in)) break;
+        else if (*in == '*')
+            skipLine(in);
+        else if (*in == 'm'){
+            if (!eagerMatch(in, "min:"))
+                fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            readTerms(in, S, obj_lits, obj_coefs);
+            if (*in != ';') fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            ++in;
+        }else{
+            readTerms(in, S, lits, coefs);
+            int rel = *in == '>' ? 1 : *in == '<' ? -1 : 0;
+            if (rel != 0) ++in;
+            if (*in != '=') fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            ++in;
+            int64_t k = parseInt64(in);
+            skipWhitespace(in);
+            if (isEof(in)) fprintf(stderr, "PARSE ERROR! Unexpected end of file\n"), exit(3);
+            if (*in != ';') fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            ++in;
+
+            if (rel >= 0)
+                S.addLinear(lits, coefs, k);
+            if (rel <= 0){
+                for (int i = 0; i < coefs.size(); i++)
+                    coefs[i] = -coefs[i];
+                S.addLinear_(lits, coefs, -k); }
+        }
+    }
+}
+
+// Inserts the problem in 'file' into solver ('NULL' reads standard input), as 'parse_DIMACS()' does
+// (but on a single thread). Returns false if the file could not be opened.
+//
+template<class Solver>
+static bool parse_OPB(const char* file, Solver& S, vec<Lit>& obj_lits, vec<int64_t>& obj_coefs) {
+    MappedFile mf;
+    if (file != NULL && mf.open(file)){
+        const char* in = mf.begin();
+        parse_OPB_main(in, S, obj_lits, obj_coefs);
+        return true; }
+
+    gzFile in = (file == NULL) ? gzdopen(0, "rb") : gzopen(file, "rb");
+    if (in == NULL)
+        return false;
+    StreamBuffer buf(in);
+    parse_OPB_main(buf, S, obj_lits, obj_coefs);
+    gzclose(in);
+    return true; }
+
 //=================================================================================================
 }
 
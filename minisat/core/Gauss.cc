@@ -0,0 +1,112 @@
+/****************************************************************************************[Gauss.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "minisat/core/Gauss.h"
+
+using namespace Minisat;
+
+
+void XorMatrix::init(const vec<Var>& vs)
+{
+    vs.copyTo(vars);
+    words = (vars.size() + 1 + 63) / 64;
+    bits   .clear();
+    pivot  .clear();
+    basic  .clear();
+    watch  .clear();
+    implied.clear();
+    pivot.growTo(vars.size(), -1);
+}
+
+
+int XorMatrix::addRow()
+{
+    bits.growTo(bits.size() + words, 0);
+    basic  .push(-1);
+    watch  .push(-1);
+    implied.push(var_Undef);
+    return nRows() - 1;
+}
+
+
+int XorMatrix::size(int r) const
+{
+    int n = 0;
+    for (int c = next(r, 0); c < nCols(); c = next(r, c + 1))
+        n++;
+    return n;
+}
+
+
+void XorMatrix::removeRow(int r)
+{
+    int last = nRows() - 1;
+    if (basic[r] >= 0) pivot[basic[r]] = -1;
+    if (r != last){
+        uint64_t* dst = row(r);
+        uint64_t* src = row(last);
+        for (int i = 0; i < words; i++)
+            dst[i] = src[i];
+        basic  [r] = basic  [last];
+        watch  [r] = watch  [last];
+        implied[r] = implied[last];
+        if (basic[r] >= 0) pivot[basic[r]] = r;
+    }
+    bits   .shrink(words);
+    basic  .pop();
+    watch  .pop();
+    implied.pop();
+}
+
+
+// Bring the rows to reduced row echelon form, taking the basic columns from left to right, and
+// remove the rows that become zero. Returns FALSE if one of them had a right hand side of one:
+bool XorMatrix::eliminate()
+{
+    for (int c = 0; c < nCols(); c++) pivot[c] = -1;
+
+    int n = 0;
+    for (int c = 0; c < nCols() && n < nRows(); c++){
+        int s = n;
+        while (s < nRows() && !get(s, c)) s++;
+        if (s == nRows()) continue;
+
+        // Move the row to position 'n' and remove column 'c' from all other rows:
+        if (s != n){
+            uint64_t* a = row(s);
+            uint64_t* b = row(n);
+            for (int i = 0; i < words; i++){
+                uint64_t tmp = a[i]; a[i] = b[i]; b[i] = tmp; }
+        }
+        for (int t = 0; t < nRows(); t++)
+            if (t != n && get(t, c))
+                addTo(t, n);
+        basic[n] = c;
+        pivot[c] = n++;
+    }
+
+    bool consistent = true;
+    for (int r = n; r < nRows(); r++)
+        if (rhs(r)) consistent = false;
+    while (nRows() > n)
+        removeRow(nRows() - 1);
+
+    return consistent;
+}
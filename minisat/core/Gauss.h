@@ -0,0 +1,113 @@
+/*****************************************************************************************[Gauss.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Gauss_h
+#define Minisat_Gauss_h
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+
+namespace Minisat {
+
+//=================================================================================================
+// XorMatrix -- a system of XOR constraints as a packed bit-matrix:
+//
+// Each row holds the coefficients of one constraint, 64 columns to a word, with the right hand side
+// as an extra last column. After 'eliminate()' the rows are in reduced row echelon form: each row
+// has a basic column, which is set in no other row. 'Solver' keeps it that way while propagating,
+// and watches two columns of each row: the basic one and one other (see 'Solver::gaussPropagate()').
+
+class XorMatrix {
+    vec<uint64_t> bits;     // The rows, 'words' words each.
+    int           words;
+
+    uint64_t*       row(int r)       { return &bits[r * words]; }
+    const uint64_t* row(int r) const { return &bits[r * words]; }
+
+    static int lowestBit(uint64_t x) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(x);
+#else
+        int i = 0;
+        while ((x & 1) == 0) x >>= 1, i++;
+        return i;
+#endif
+    }
+
+ public:
+    vec<Var>    vars;       // The variable of each column.
+    vec<int>    pivot;      // The row each column is the basic column of, or -1.
+    vec<int>    basic;      // The basic column of each row..
+    vec<int>    watch;      // .. and the other watched one.
+    vec<Var>    implied;    // The variable each row last implied (see 'Solver::lazyReason()').
+    int         first;      // The number of the first row, among the rows of all matrices.
+
+    XorMatrix() : words(0), first(0) {}
+
+    void init      (const vec<Var>& vs);                  // Set the columns (without any rows).
+    int  nRows     ()             const { return words == 0 ? 0 : bits.size() / words; }
+    int  nCols     ()             const { return vars.size(); }
+    int  addRow    ();                                    // Add a zero row and return its index.
+    bool get       (int r, int c) const { return (row(r)[c >> 6] >> (c & 63)) & 1; }
+    void flip      (int r, int c)       { row(r)[c >> 6] ^= (uint64_t)1 << (c & 63); }
+    bool rhs       (int r)        const { return get(r, nCols()); }
+    int  next      (int r, int c) const;                  // The first column from 'c' set in row 'r', or 'nCols()'.
+    int  size      (int r)        const;                  // The number of columns set in row 'r'.
+    void addTo     (int r, int s);                        // Add row 's' to row 'r'.
+    void removeRow (int r);                               // Remove a row (the last row takes its place).
+    bool eliminate ();                                    // Gauss-Jordan elimination (FALSE if the rows are inconsistent).
+};
+
+
+//=================================================================================================
+// Implementation of inline methods:
+
+
+inline int XorMatrix::next(int r, int c) const
+{
+    if (c >= nCols()) return nCols();
+    const uint64_t* rw = row(r);
+    int             w  = c >> 6;
+    uint64_t        b  = rw[w] & (~(uint64_t)0 << (c & 63));
+    for (;;){
+        if (b != 0){
+            c = (w << 6) + lowestBit(b);
+            return c < nCols() ? c : nCols(); }
+        if (++w == words)
+            return nCols();
+        b = rw[w];
+    }
+}
+
+
+inline void XorMatrix::addTo(int r, int s)
+{
+    uint64_t*       dst = row(r);
+    const uint64_t* src = row(s);
+    for (int i = 0; i < words; i++)
+        dst[i] ^= src[i];
+}
+
+
+//=================================================================================================
+}
+
+#endif
@@ -64,6 +64,10 @@ int main(int argc, char** argv)
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", 0, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", 0, IntRange(0, INT32_MAX));
         BoolOption   strictp("MAIN", "strict", "Validate DIMACS header during parsing.", false);
+        IntOption    parse_threads("MAIN", "parse-threads", "Threads used to read uncompressed input (0 = one per hardware thread).", 1, IntRange(0, INT32_MAX));
+        StringOption proof  ("MAIN", "proof",  "If given, write a proof of unsatisfiability to this file.");
+        BoolOption   proof_bin("MAIN", "proof-binary", "Write the proof in binary format.", true);
+        BoolOption   lrat   ("MAIN", "lrat",   "Write an LRAT proof (with clause numbers and hints) instead of DRAT.", false);
         
         parseOptions(argc, argv, true);
 
@@ -84,16 +88,15 @@ int main(int argc, char** argv)
         if (argc == 1)
             printf("Reading from standard input... Use '--help' for help.\n");
         
-        gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
-        if (in == NULL)
-            printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
-        
         if (S.verbosity > 0){
             printf("============================[ Problem Statistics ]=============================\n");
             printf("|                                                                             |\n"); }
         
-        parse_DIMACS(in, S, (bool)strictp);
-        gzclose(in);
+        if (proof && !S.openProof((const char*)proof, (bool)proof_bin, (bool)lrat))
+            printf("ERROR! Could not open proof file: %s\n", (const char*)proof), exit(1);
+
+        if (!parse_DIMACS(argc == 1 ? NULL : argv[1], S, (bool)strictp, parse_threads))
+            printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
         FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
         
         if (S.verbosity > 0){
@@ -117,6 +120,7 @@ int main(int argc, char** argv)
                 S.printStats();
                 printf("\n"); }
             printf("UNSATISFIABLE\n");
+            S.closeProof();
             exit(20);
         }
         
@@ -139,6 +143,7 @@ int main(int argc, char** argv)
                 fprintf(res, "INDET\n");
             fclose(res);
         }
+        S.closeProof();
         
 #ifdef NDEBUG
         exit(ret == l_True ? 10 : ret == l_False ? 20 : 0);     // (faster than "return", which will invoke the destructor for 'Solver')
@@ -0,0 +1,130 @@
+/****************************************************************************************[Proof.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdio.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "minisat/core/Proof.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Writer thread:
+//
+// Owns the second buffer. 'Proof::flush()' swaps the solver's buffer with it as soon as the previous
+// one has been written, so the solver only waits if it produces proof lines faster than the disk
+// can take them.
+
+
+struct Proof::Writer {
+    FILE*                   out;
+    vec<unsigned char>      buf;
+    bool                    full;       // 'buf' holds lines that have not been written yet.
+    bool                    done;       // No more lines will be handed over.
+    std::mutex              mtx;
+    std::condition_variable cond;
+    std::thread             thread;
+
+    explicit Writer(FILE* f) : out(f), full(false), done(false), thread(&Writer::run, this) {}
+
+    void run(){
+        std::unique_lock<std::mutex> lock(mtx);
+        for (;;){
+            while (!full && !done) cond.wait(lock);
+            if (!full) break;
+
+            lock.unlock();
+            fwrite((unsigned char*)buf, 1, buf.size(), out);
+            lock.lock();
+            buf.clear();
+            full = false;
+            cond.notify_all();
+        }
+    }
+
+    // Hand over 'b' and get the previously written (empty) buffer back:
+    void swap(vec<unsigned char>& b){
+        std::unique_lock<std::mutex> lock(mtx);
+        while (full) cond.wait(lock);
+        vec<unsigned char> tmp;
+        buf.moveTo(tmp);
+        b  .moveTo(buf);
+        tmp.moveTo(b);
+        full = true;
+        cond.notify_all();
+    }
+
+    void finish(){
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            done = true;
+            cond.notify_all();
+        }
+        thread.join();
+    }
+};
+
+
+//=================================================================================================
+// Proof:
+
+
+Proof::Proof() : writer(NULL), binary(true), lrat_(false), last_id(0), input_id(0), input_end(0) {}
+Proof::~Proof() { close(); }
+
+
+bool Proof::open(const char* file, bool bin, bool lr)
+{
+    close();
+
+    FILE* f = fopen(file, "wb");
+    if (f == NULL)
+        return false;
+
+    binary    = bin;
+    lrat_     = lr;
+    last_id   = 0;
+    input_id  = 0;
+    input_end = 0;
+    buf.clear();
+    buf.capacity(flush_size + flush_size / 4);
+    writer    = new Writer(f);
+    return true;
+}
+
+
+void Proof::flush() { writer->swap(buf); }
+
+
+void Proof::close()
+{
+    if (writer == NULL) return;
+
+    if (buf.size() > 0)
+        writer->swap(buf);
+    writer->finish();
+    fclose(writer->out);
+    delete writer;
+    writer = NULL;
+    buf.clear(true);
+}
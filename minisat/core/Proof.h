@@ -0,0 +1,169 @@
+/*****************************************************************************************[Proof.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Proof_h
+#define Minisat_Proof_h
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+
+namespace Minisat {
+
+//=================================================================================================
+// Proof -- a DRAT or LRAT proof of unsatisfiability written by a background thread:
+//
+// Proof lines are encoded into a buffer owned by the solver thread. Full buffers are handed over to
+// a writer thread, which writes them while the solver fills the other buffer. Both the binary and
+// the textual variant of each format are supported. In LRAT mode, every clause is identified by a
+// number: the input clauses are numbered from 1 in the order they are given ('inputId()'), and each
+// derived clause gets the next free number ('newId()'). Clauses may be derived before all input
+// clauses are given, so the number of input clauses should be reserved in advance ('reserveIds()').
+// Input clauses beyond the reserved numbers take the next free number, like derived clauses, so no
+// number is ever given twice (but the proof then only matches the input if no clause was derived
+// in between).
+
+class Proof {
+ public:
+    Proof();
+    ~Proof();
+
+    bool     open    (const char* file, bool binary = true, bool lrat = false);
+    void     close   ();                // Write all buffered lines and close the file.
+
+    bool     lrat    () const { return lrat_; }
+    uint64_t newId   ()       { return ++last_id; }
+    uint64_t inputId ()       { return input_id < input_end ? ++input_id : newId(); }
+    void     reserveIds(uint64_t n);
+
+    // Adding and deleting clauses ('id' and 'hints' are only used in LRAT mode):
+    //
+    void     add     (uint64_t id, const Lit* lits, int size, const vec<uint64_t>& hints);
+    void     add     (const Lit* lits, int size);
+    void     remove  (uint64_t id, const Lit* lits, int size);
+
+ protected:
+    struct Writer;
+
+    Writer*             writer;
+    vec<unsigned char>  buf;            // Lines not yet handed over to the writer.
+    bool                binary;
+    bool                lrat_;
+    uint64_t            last_id;
+    uint64_t            input_id;       // The number of the last input clause given a reserved number.
+    uint64_t            input_end;      // The last reserved number.
+
+    enum { flush_size = 1024*1024 };
+
+    void     reserve (int bytes) { if (buf.size() + bytes > buf.capacity()) buf.capacity(buf.size() + bytes); }
+    void     flush   ();
+    void     putNum  (uint64_t x, bool neg = false);
+    void     putLit  (Lit p)     { putNum(var(p)+1, sign(p)); }
+    void     putEnd  ()          { if (binary) buf.push_(0); else buf.push_('0'), buf.push_(' '); }
+    void     endLine ()          { if (!binary) buf[buf.size()-1] = '\n';
+                                   if (buf.size() >= flush_size) flush(); }
+};
+
+
+//=================================================================================================
+// Implementation of inline methods:
+
+
+inline void Proof::putNum(uint64_t x, bool neg)
+{
+    if (binary){
+        // Binary DRAT/LRAT numbers: '2*x + neg' in 7-bit groups, least significant group first:
+        uint64_t u = 2*x + (uint64_t)neg;
+        while (u > 127){
+            buf.push_((unsigned char)((u & 127) | 128));
+            u >>= 7; }
+        buf.push_((unsigned char)u);
+    }else{
+        unsigned char tmp[20];
+        int           n = 0;
+        do tmp[n++] = (unsigned char)('0' + x % 10); while ((x /= 10) != 0);
+        if (neg) buf.push_('-');
+        while (n > 0) buf.push_(tmp[--n]);
+        buf.push_(' ');
+    }
+}
+
+
+inline void Proof::reserveIds(uint64_t n)
+{
+    if (input_end - input_id >= n) return;
+
+    // Extend the reserved numbers if no clause was numbered after them, or start anew:
+    if (input_end != last_id) input_id = last_id;
+    input_end = last_id = input_id + n;
+}
+
+
+inline void Proof::add(uint64_t id, const Lit* lits, int size, const vec<uint64_t>& hints)
+{
+    if (!lrat_){
+        add(lits, size);
+        return; }
+
+    reserve(24 * (size + hints.size() + 3));
+    if (binary) buf.push_('a');
+    putNum(id);
+    for (int i = 0; i < size; i++) putLit(lits[i]);
+    putEnd();
+    for (int i = 0; i < hints.size(); i++) putNum(hints[i]);
+    putEnd();
+    endLine();
+}
+
+
+inline void Proof::add(const Lit* lits, int size)
+{
+    assert(!lrat_);
+    reserve(24 * (size + 2));
+    if (binary) buf.push_('a');
+    for (int i = 0; i < size; i++) putLit(lits[i]);
+    putEnd();
+    endLine();
+}
+
+
+inline void Proof::remove(uint64_t id, const Lit* lits, int size)
+{
+    reserve(24 * (size + 3));
+    if (lrat_){
+        // NOTE: the textual LRAT format requires a (here: the latest) clause number in front.
+        if (!binary) putNum(last_id);
+        buf.push_('d');
+        if (!binary) buf.push_(' ');
+        putNum(id);
+    }else{
+        buf.push_('d');
+        if (!binary) buf.push_(' ');
+        for (int i = 0; i < size; i++) putLit(lits[i]);
+    }
+    putEnd();
+    endLine();
+}
+
+
+//=================================================================================================
+}
+
+#endif
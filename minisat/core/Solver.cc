@@ -24,6 +24,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "minisat/mtl/Sort.h"
 #include "minisat/utils/System.h"
 #include "minisat/core/Solver.h"
+#include "minisat/core/Walk.h"
 
 using namespace Minisat;
 
@@ -43,8 +44,26 @@ static BoolOption    opt_rnd_init_act      (_cat, "rnd-init",    "Randomize the
 static BoolOption    opt_luby_restart      (_cat, "luby",        "Use the Luby restart sequence", true);
 static IntOption     opt_restart_first     (_cat, "rfirst",      "The base restart interval", 100, IntRange(1, INT32_MAX));
 static DoubleOption  opt_restart_inc       (_cat, "rinc",        "Restart interval increase factor", 2, DoubleRange(1, false, HUGE_VAL, false));
+static IntOption     opt_restart_mode      (_cat, "restarts",    "Restart policy (0=luby/geometric, 1=dynamic, 2=alternate stable and focused phases)", 0, IntRange(0, 2));
+static DoubleOption  opt_restart_margin    (_cat, "restart-margin", "Restart if the fast LBD average exceeds the slow one by this factor", 1.1, DoubleRange(1, true, HUGE_VAL, false));
+static DoubleOption  opt_restart_block     (_cat, "restart-block", "Block restarts while the trail is longer than its average by this factor", 1.4, DoubleRange(1, true, HUGE_VAL, false));
+static IntOption     opt_mode_first        (_cat, "mode-first",  "The number of conflicts of the first focused phase", 1000, IntRange(1, INT32_MAX));
+static IntOption     opt_branching         (_cat, "branch",      "Decision heuristic (0=VSIDS, 1=VMTF, 2=LRB)", 0, IntRange(0, 2));
+static IntOption     opt_branch_stable     (_cat, "branch-stable", "Decision heuristic of stable phases (-1=same as 'branch', 0=VSIDS, 1=VMTF, 2=LRB)", -1, IntRange(-1, 2));
+static DoubleOption  opt_lrb_step_min      (_cat, "lrb-step-min", "The final step size of the LRB activity averages", 0.06, DoubleRange(0, false, 0.4, true));
+static IntOption     opt_target_mode       (_cat, "target",      "Decide on the target phase (0=never, 1=in stable phases, 2=always)", 0, IntRange(0, 2));
+static IntOption     opt_rephase_first     (_cat, "rephase",     "Conflicts before the first rephasing (0=never)", 0, IntRange(0, INT32_MAX));
+static IntOption     opt_walk_flips        (_cat, "walk-flips",  "Flips of the first local search when rephasing (0=never)", 0, IntRange(0, INT32_MAX));
+static IntOption     opt_inprocess_first   (_cat, "inprocess",   "Conflicts before the first inprocessing round (0=never)", 0, IntRange(0, INT32_MAX));
+static DoubleOption  opt_inprocess_effort  (_cat, "inprocess-effort", "Ticks of each inprocessing technique relative to the propagations of the search", 0.1, DoubleRange(0, true, HUGE_VAL, false));
+static BoolOption    opt_use_vivify        (_cat, "vivify",      "Vivify learnt clauses when inprocessing", true);
+static BoolOption    opt_use_probe         (_cat, "probe",       "Probe the roots of the binary implication graph when inprocessing", true);
 static DoubleOption  opt_garbage_frac      (_cat, "gc-frac",     "The fraction of wasted memory allowed before a garbage collection is triggered",  0.20, DoubleRange(0, false, HUGE_VAL, false));
 static IntOption     opt_min_learnts_lim   (_cat, "min-learnts", "Minimum learnt clause limit",  0, IntRange(0, INT32_MAX));
+static IntOption     opt_core_lbd          (_cat, "core-lbd",    "Learnt clauses with at most this LBD are never removed", 2, IntRange(0, INT32_MAX));
+static IntOption     opt_tier2_lbd         (_cat, "tier2-lbd",   "Learnt clauses with at most this LBD are kept while they are used", 6, IntRange(0, INT32_MAX));
+static BoolOption    opt_reuse_trail       (_cat, "reuse-trail", "Keep the decision levels that would be decided again on restarts", false);
+static IntOption     opt_chrono            (_cat, "chrono",      "Backtrack chronologically if the backjump would skip more levels than this (-1=never)", -1, IntRange(-1, INT32_MAX));
 
 
 //=================================================================================================
@@ -67,8 +86,26 @@ Solver::Solver() :
   , rnd_init_act     (opt_rnd_init_act)
   , garbage_frac     (opt_garbage_frac)
   , min_learnts_lim  (opt_min_learnts_lim)
+  , core_lbd         (opt_core_lbd)
+  , tier2_lbd        (opt_tier2_lbd)
+  , chrono           (opt_chrono)
+  , reuse_trail      (opt_reuse_trail)
   , restart_first    (opt_restart_first)
   , restart_inc      (opt_restart_inc)
+  , restart_mode     (opt_restart_mode)
+  , restart_margin   (opt_restart_margin)
+  , restart_block    (opt_restart_block)
+  , mode_first       (opt_mode_first)
+  , branching        (opt_branching)
+  , branch_stable    (opt_branch_stable)
+  , lrb_step_min     (opt_lrb_step_min)
+  , target_mode      (opt_target_mode)
+  , rephase_first    (opt_rephase_first)
+  , walk_flips       (opt_walk_flips)
+  , inprocess_first  (opt_inprocess_first)
+  , inprocess_effort (opt_inprocess_effort)
+  , use_vivify       (opt_use_vivify)
+  , use_probe        (opt_use_probe)
 
     // Parameters (the rest):
     //
@@ -81,11 +118,17 @@ Solver::Solver() :
 
     // Statistics: (formerly in 'SolverStats')
     //
-  , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0)
+  , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0), chrono_backtracks(0)
+  , blocked_restarts(0), mode_switches(0), rephases(0), walks(0), walk_flipped(0), inprocessings(0)
+  , vivified_clauses(0), vivified_lits(0), probes(0), failed_lits(0), lifted_lits(0), hbr_clauses(0), xor_props(0), xor_conflicts(0)
+  , card_props(0), card_conflicts(0), linear_props(0), linear_conflicts(0)
   , dec_vars(0), num_clauses(0), num_learnts(0), clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
 
   , watches            (WatcherDeleted(ca))
+  , watches_bin        (WatcherDeleted(ca))
   , order_heap         (VarOrderLt(activity))
+  , lrb_step           (0.4)
+  , heuristic          (branch_vsids)
   , ok                 (true)
   , cla_inc            (1)
   , var_inc            (1)
@@ -95,6 +138,24 @@ Solver::Solver() :
   , progress_estimate  (0)
   , remove_satisfied   (true)
   , next_var           (0)
+  , lbd_stamp          (0)
+  , proof              (NULL)
+  , proof_units        (0)
+  , add_id             (0)
+  , lbd_fast           (1.0 / 32)
+  , lbd_slow           (1e-5)
+  , trail_avg          (1.0 / 5000)
+  , focused            (false)
+  , mode_limit         (0)
+  , mode_var_inc       (1)
+  , target_assigned    (0)
+  , best_assigned      (0)
+  , rephase_limit      (0)
+  , inprocess_limit    (0)
+  , inprocess_props    (0)
+  , probe_next         (0)
+  , lazy_sweep         (false)
+  , kept_learnts       (0)
 
     // Resource constraints:
     //
@@ -106,6 +167,15 @@ Solver::Solver() :
 
 Solver::~Solver()
 {
+    closeProof();
+    for (int i = 0; i < xor_matrices.size(); i++)
+        delete xor_matrices[i];
+    for (int v = 0; v < xor_watches.size(); v++)
+        delete xor_watches[v];
+    for (int i = 0; i < card_watches.size(); i++)
+        delete card_watches[i];
+    for (int i = 0; i < lin_watches.size(); i++)
+        delete lin_watches[i];
 }
 
 
@@ -113,6 +183,14 @@ Solver::~Solver()
 // Minor methods:
 
 
+// Grows 'ws' to hold at least 'size' (empty) lists. The lists are allocated separately since 'vec'
+// moves its elements with 'realloc()':
+static void growWatchLists(vec<vec<int>*>& ws, int size)
+{
+    while (ws.size() < size)
+        ws.push(new vec<int>());
+}
+
 // Creates a new SAT variable in the solver. If 'decision' is cleared, variable will not be
 // used as a decision variable (NOTE! This has effects on the meaning of a SATISFIABLE result).
 //
@@ -127,11 +205,21 @@ Var Solver::newVar(lbool upol, bool dvar)
 
     watches  .init(mkLit(v, false));
     watches  .init(mkLit(v, true ));
+    watches_bin.init(mkLit(v, false));
+    watches_bin.init(mkLit(v, true ));
     assigns  .insert(v, l_Undef);
     vardata  .insert(v, mkVarData(CRef_Undef, 0));
+    unit_id  .insert(v, 0);
+    lazy_from.insert(v, 0);
     activity .insert(v, rnd_init_act ? drand(random_seed) * 0.00001 : 0);
+    mode_activity.insert(v, activity[v]);
+    vmtf     .insert(v);
+    LrbData l = { 0, 0, 0, 0 };
+    lrb      .insert(v, l);
     seen     .insert(v, 0);
     polarity .insert(v, true);
+    target_phase.insert(v, true);
+    best_phase.insert(v, true);
     user_pol .insert(v, upol);
     decision .reserve(v);
     trail    .capacity(v+1);
@@ -140,6 +228,46 @@ Var Solver::newVar(lbool upol, bool dvar)
 }
 
 
+// The proof numbers of all 'n_clauses' input clauses are reserved, but memory only for a limited
+// number of variables and clauses. If that fails, the solver simply grows on demand instead.
+void Solver::reserve(int n_vars, int n_clauses, uint64_t n_lits)
+{
+    if (proof != NULL && n_clauses > 0)
+        proof->reserveIds(n_clauses);
+
+    if (n_vars > reserve_vars_max) n_vars = reserve_vars_max;
+    if (n_clauses > reserve_clauses_max){
+        n_lits    = n_lits / n_clauses * reserve_clauses_max;
+        n_clauses = reserve_clauses_max; }
+
+    try {
+        if (n_vars > 0){
+            Var v = n_vars - 1;
+            watches    .capacity(mkLit(v, true));
+            watches_bin.capacity(mkLit(v, true));
+            assigns    .capacity(v);
+            vardata    .capacity(v);
+            lazy_from  .capacity(v);
+            activity   .capacity(v);
+            mode_activity.capacity(v);
+            vmtf       .capacity(v);
+            lrb        .capacity(v);
+            seen       .capacity(v);
+            polarity   .capacity(v);
+            target_phase.capacity(v);
+            best_phase .capacity(v);
+            user_pol   .capacity(v);
+            decision   .capacity(v);
+            trail      .capacity(n_vars);
+        }
+        if (n_clauses > 0){
+            ca.reserve(n_clauses, n_lits);
+            clauses.capacity(clauses.size() + n_clauses);
+        }
+    } catch (OutOfMemoryException&){}
+}
+
+
 // Note: at the moment, only unassigned variable will be released (this is to avoid duplicate
 // releases of the same variable).
 void Solver::releaseVar(Lit l)
@@ -154,8 +282,20 @@ void Solver::releaseVar(Lit l)
 bool Solver::addClause_(vec<Lit>& ps)
 {
     assert(decisionLevel() == 0);
+    uint64_t id = takeAddId();
     if (!ok) return false;
 
+    // Collect the hints for removing false literals, in case a proof is logged:
+    int n_false = 0;
+    if (proof != NULL){
+        proofUnits();
+        proof_hints.clear();
+        for (int i = 0; i < ps.size(); i++)
+            if (value(ps[i]) == l_False){
+                n_false++;
+                if (lrat()) proof_hints.push(unit_id[var(ps[i])]); }
+    }
+
     // Check if clause is satisfied and remove false/duplicate literals:
     sort(ps);
     Lit p; int i, j;
@@ -166,13 +306,22 @@ bool Solver::addClause_(vec<Lit>& ps)
             ps[j++] = p = ps[i];
     ps.shrink(i - j);
 
+    if (n_false > 0){
+        if (lrat()) proof_hints.push(id);
+        id = proofAdd(ps, proof_hints); }
+
     if (ps.size() == 0)
         return ok = false;
     else if (ps.size() == 1){
+        unit_id[var(ps[0])] = id;
         uncheckedEnqueue(ps[0]);
-        return ok = (propagate() == CRef_Undef);
+        CRef confl = propagate();
+        if (confl != CRef_Undef)
+            proofEmpty(confl);
+        return ok = (confl == CRef_Undef);
     }else{
         CRef cr = ca.alloc(ps, false);
+        if (ca[cr].has_id()) ca[cr].id(id);
         clauses.push(cr);
         attachClause(cr);
     }
@@ -184,8 +333,9 @@ bool Solver::addClause_(vec<Lit>& ps)
 void Solver::attachClause(CRef cr){
     const Clause& c = ca[cr];
     assert(c.size() > 1);
-    watches[~c[0]].push(Watcher(cr, c[1]));
-    watches[~c[1]].push(Watcher(cr, c[0]));
+    OccLists<Lit, vec<Watcher>, WatcherDeleted, MkIndexLit>& ws = c.size() == 2 ? watches_bin : watches;
+    ws[~c[0]].push(Watcher(cr, c[1]));
+    ws[~c[1]].push(Watcher(cr, c[0]));
     if (c.learnt()) num_learnts++, learnts_literals += c.size();
     else            num_clauses++, clauses_literals += c.size();
 }
@@ -194,14 +344,15 @@ void Solver::attachClause(CRef cr){
 void Solver::detachClause(CRef cr, bool strict){
     const Clause& c = ca[cr];
     assert(c.size() > 1);
+    OccLists<Lit, vec<Watcher>, WatcherDeleted, MkIndexLit>& ws = c.size() == 2 ? watches_bin : watches;
     
     // Strict or lazy detaching:
     if (strict){
-        remove(watches[~c[0]], Watcher(cr, c[1]));
-        remove(watches[~c[1]], Watcher(cr, c[0]));
+        remove(ws[~c[0]], Watcher(cr, c[1]));
+        remove(ws[~c[1]], Watcher(cr, c[0]));
     }else{
-        watches.smudge(~c[0]);
-        watches.smudge(~c[1]);
+        ws.smudge(~c[0]);
+        ws.smudge(~c[1]);
     }
 
     if (c.learnt()) num_learnts--, learnts_literals -= c.size();
@@ -209,11 +360,17 @@ void Solver::detachClause(CRef cr, bool strict){
 }
 
 
-void Solver::removeClause(CRef cr) {
+void Solver::removeClause(CRef cr, bool proof_del) {
     Clause& c = ca[cr];
     detachClause(cr);
+    if (proof != NULL){
+        if (locked(c)) proofUnits(); // (log the implied unit while its reason is still part of the proof)
+        if (proof_del) proofDelete(c); }
     // Don't leave pointers to free'd memory!
-    if (locked(c)) vardata[var(c[0])].reason = CRef_Undef;
+    if (locked(c)){
+        Var x = var(c[c.size() == 2 && value(c[0]) != l_True ? 1 : 0]);
+        vardata[x].reason = CRef_Undef;
+        vardata[x].bin    = lit_Undef; }
     c.mark(1); 
     ca.free(cr);
 }
@@ -227,18 +384,30 @@ bool Solver::satisfied(const Clause& c) const {
 
 
 // Revert to the state at given level (keeping all assignment at 'level' but not beyond).
+// NOTE: after chronological backtracking, the trail above 'trail_lim[level]' may contain literals
+// implied at or below 'level'. These are kept (in order) and will be propagated again.
 //
-void Solver::cancelUntil(int level) {
+void Solver::cancelUntil(int level, bool save_phases) {
     if (decisionLevel() > level){
+        cancel_tmp.clear();
         for (int c = trail.size()-1; c >= trail_lim[level]; c--){
             Var      x  = var(trail[c]);
+            if (vardata[x].level <= level){
+                cancel_tmp.push(trail[c]);
+                continue; }
             assigns [x] = l_Undef;
-            if (phase_saving > 1 || (phase_saving == 1 && c > trail_lim.last()))
+            if (save_phases && (phase_saving > 1 || (phase_saving == 1 && c > trail_lim.last())))
                 polarity[x] = sign(trail[c]);
+            if (heuristic == branch_lrb)
+                lrbUnassign(x);
             insertVarOrder(x); }
         qhead = trail_lim[level];
         trail.shrink(trail.size() - trail_lim[level]);
         trail_lim.shrink(trail_lim.size() - level);
+        for (int i = cancel_tmp.size()-1; i >= 0; i--)
+            trail.push_(cancel_tmp[i]);
+        if (lazy_clauses.size() > 0)
+            lazy_sweep = true;
     } }
 
 
@@ -246,23 +415,57 @@ void Solver::cancelUntil(int level) {
 // Major methods:
 
 
+Var Solver::vmtfNext()
+{
+    Var v = vmtf.next();
+    while (v != var_Undef && (value(v) != l_Undef || !decision[v]))
+        v = vmtf.prev(v);
+    vmtf.setNext(v);
+    return v;
+}
+
+
+// Move the variables bumped in the last conflict to the front of the VMTF queue, keeping their
+// relative order.
+void Solver::vmtfBump()
+{
+    sort(vmtf_bumped, VmtfLt(vmtf));
+    for (int i = 0; i < vmtf_bumped.size(); i++)
+        vmtf.bump(vmtf_bumped[i]);
+    vmtf_bumped.clear();
+}
+
+
 Lit Solver::pickBranchLit()
 {
     Var next = var_Undef;
 
-    // Random decision:
-    if (drand(random_seed) < random_var_freq && !order_heap.empty()){
-        next = order_heap[irand(random_seed,order_heap.size())];
-        if (value(next) == l_Undef && decision[next])
-            rnd_decisions++; }
-
-    // Activity based decision:
-    while (next == var_Undef || value(next) != l_Undef || !decision[next])
-        if (order_heap.empty()){
-            next = var_Undef;
-            break;
-        }else
-            next = order_heap.removeMin();
+    if (heuristic == branch_vmtf)
+        // Most recently bumped variable:
+        next = vmtfNext();
+    else{
+        // LRB: decay the activity of the best candidates for the conflicts they were unassigned:
+        if (heuristic == branch_lrb)
+            while (!order_heap.empty() && lrb[order_heap[0]].canceled < conflicts){
+                Var v = order_heap[0];
+                activity[v] *= pow(0.95, (double)(conflicts - lrb[v].canceled));
+                lrb[v].canceled = conflicts;
+                order_heap.increase(v); }
+
+        // Random decision:
+        if (drand(random_seed) < random_var_freq && !order_heap.empty()){
+            next = order_heap[irand(random_seed,order_heap.size())];
+            if (value(next) == l_Undef && decision[next])
+                rnd_decisions++; }
+
+        // Activity based decision:
+        while (next == var_Undef || value(next) != l_Undef || !decision[next])
+            if (order_heap.empty()){
+                next = var_Undef;
+                break;
+            }else
+                next = order_heap.removeMin();
+    }
 
     // Choose polarity based on different polarity modes (global or per-variable):
     if (next == var_Undef)
@@ -271,6 +474,8 @@ Lit Solver::pickBranchLit()
         return mkLit(next, user_pol[next] == l_True);
     else if (rnd_pol)
         return mkLit(next, drand(random_seed) < 0.5);
+    else if (useTarget())
+        return mkLit(next, target_phase[next]);
     else
         return mkLit(next, polarity[next]);
 }
@@ -278,7 +483,7 @@ Lit Solver::pickBranchLit()
 
 /*_________________________________________________________________________________________________
 |
-|  analyze : (confl : Clause*) (out_learnt : vec<Lit>&) (out_btlevel : int&)  ->  [void]
+|  analyze : (confl : Clause*) (out_learnt : vec<Lit>&) (out_btlevel : int&) (out_lbd : uint32_t&)  ->  [void]
 |  
 |  Description:
 |    Analyze conflict and produce a reason clause.
@@ -286,14 +491,16 @@ Lit Solver::pickBranchLit()
 |    Pre-conditions:
 |      * 'out_learnt' is assumed to be cleared.
 |      * Current decision level must be greater than root level.
+|      * 'confl' has at least two literals on the current decision level (see 'conflictLevel()').
 |  
 |    Post-conditions:
 |      * 'out_learnt[0]' is the asserting literal at level 'out_btlevel'.
 |      * If out_learnt.size() > 1 then 'out_learnt[1]' has the greatest decision level of the 
 |        rest of literals. There may be others from the same level though.
+|      * 'out_lbd' is the number of distinct decision levels in 'out_learnt'.
 |  
 |________________________________________________________________________________________________@*/
-void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
+void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel, uint32_t& out_lbd)
 {
     int pathC = 0;
     Lit p     = lit_Undef;
@@ -305,13 +512,10 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
 
     do{
         assert(confl != CRef_Undef); // (otherwise should be UIP)
-        Clause& c = ca[confl];
 
-        if (c.learnt())
-            claBumpActivity(c);
-
-        for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++){
-            Lit q = c[j];
+        if (p != lit_Undef && binReason(var(p)) != lit_Undef){
+            // Binary reason, no need to look at the clause:
+            Lit q = binReason(var(p));
 
             if (!seen[var(q)] && level(var(q)) > 0){
                 varBumpActivity(var(q));
@@ -321,17 +525,51 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
                 else
                     out_learnt.push(q);
             }
+        }else{
+            Clause& c = ca[confl];
+
+            if (c.learnt()){
+                claBumpActivity(c);
+                c.used(true);
+
+                // Update LBD and move the clause to a better tier if it improved:
+                if (c.tier() != tier_core){
+                    uint32_t lbd = computeLBD(c);
+                    if (lbd < c.lbd()){
+                        c.lbd(lbd);
+                        if (lbdTier(lbd) < (int)c.tier())
+                            c.tier(lbdTier(lbd));
+                    }
+                }
+            }
+
+            for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++){
+                Lit q = c[j];
+
+                if (!seen[var(q)] && level(var(q)) > 0){
+                    varBumpActivity(var(q));
+                    seen[var(q)] = 1;
+                    if (level(var(q)) >= decisionLevel())
+                        pathC++;
+                    else
+                        out_learnt.push(q);
+                }
+            }
         }
         
-        // Select next clause to look at:
-        while (!seen[var(trail[index--])]);
-        p     = trail[index+1];
+        // Select next clause to look at (skipping lower levels, which may be interleaved with the
+        // current one after chronological backtracking):
+        do{
+            while (!seen[var(trail[index--])]);
+            p = trail[index+1];
+        }while (level(var(p)) < decisionLevel());
         confl = reason(var(p));
         seen[var(p)] = 0;
         pathC--;
 
     }while (pathC > 0);
     out_learnt[0] = ~p;
+    if (heuristic == branch_vmtf) vmtfBump();
 
     // Simplify conflict clause:
     //
@@ -348,7 +586,11 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
 
             if (reason(x) == CRef_Undef)
                 out_learnt[j++] = out_learnt[i];
-            else{
+            else if (binReason(x) != lit_Undef){
+                Lit q = binReason(x);
+                if (!seen[var(q)] && level(var(q)) > 0)
+                    out_learnt[j++] = out_learnt[i];
+            }else{
                 Clause& c = ca[reason(var(out_learnt[i]))];
                 for (int k = 1; k < c.size(); k++)
                     if (!seen[var(c[k])] && level(var(c[k])) > 0){
@@ -362,6 +604,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
     max_literals += out_learnt.size();
     out_learnt.shrink(i - j);
     tot_literals += out_learnt.size();
+    if (heuristic == branch_lrb) lrbReasoned(out_learnt);
 
     // Find correct backtrack level:
     //
@@ -379,6 +622,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
         out_learnt[1]     = p;
         out_btlevel       = level(var(p));
     }
+    out_lbd = computeLBD(out_learnt);
 
     for (int j = 0; j < analyze_toclear.size(); j++) seen[var(analyze_toclear[j])] = 0;    // ('seen[]' is now cleared)
 }
@@ -391,14 +635,15 @@ bool Solver::litRedundant(Lit p)
     assert(seen[var(p)] == seen_undef || seen[var(p)] == seen_source);
     assert(reason(var(p)) != CRef_Undef);
 
-    Clause*               c     = &ca[reason(var(p))];
+    // NOTE: 'c' is left as NULL for binary reasons; the single parent is then found in 'vardata'.
+    Clause*               c     = binReason(var(p)) != lit_Undef ? NULL : &ca[reason(var(p))];
     vec<ShrinkStackElem>& stack = analyze_stack;
     stack.clear();
 
     for (uint32_t i = 1; ; i++){
-        if (i < (uint32_t)c->size()){
+        if (i < (c == NULL ? 2u : (uint32_t)c->size())){
             // Checking 'p'-parents 'l':
-            Lit l = (*c)[i];
+            Lit l = c == NULL ? binReason(var(p)) : (*c)[i];
             
             // Variable at level 0 or previously removable:
             if (level(var(l)) == 0 || seen[var(l)] == seen_source || seen[var(l)] == seen_removable){
@@ -420,7 +665,7 @@ bool Solver::litRedundant(Lit p)
             stack.push(ShrinkStackElem(i, p));
             i  = 0;
             p  = l;
-            c  = &ca[reason(var(p))];
+            c  = binReason(var(p)) != lit_Undef ? NULL : &ca[reason(var(p))];
         }else{
             // Finished with current element 'p' and reason 'c':
             if (seen[var(p)] == seen_undef){
@@ -434,7 +679,7 @@ bool Solver::litRedundant(Lit p)
             // Continue with top element on stack:
             i  = stack.last().i;
             p  = stack.last().l;
-            c  = &ca[reason(var(p))];
+            c  = binReason(var(p)) != lit_Undef ? NULL : &ca[reason(var(p))];
 
             stack.pop();
         }
@@ -458,7 +703,8 @@ void Solver::analyzeFinal(Lit p, LSet& out_conflict)
     out_conflict.clear();
     out_conflict.insert(p);
 
-    if (decisionLevel() == 0)
+    // NOTE: after chronological backtracking, 'p' may have been assigned at level 0 after 'trail_lim[0]':
+    if (decisionLevel() == 0 || level(var(p)) == 0)
         return;
 
     seen[var(p)] = 1;
@@ -469,6 +715,9 @@ void Solver::analyzeFinal(Lit p, LSet& out_conflict)
             if (reason(x) == CRef_Undef){
                 assert(level(x) > 0);
                 out_conflict.insert(~trail[i]);
+            }else if (binReason(x) != lit_Undef){
+                if (level(var(binReason(x))) > 0)
+                    seen[var(binReason(x))] = 1;
             }else{
                 Clause& c = ca[reason(x)];
                 for (int j = 1; j < c.size(); j++)
@@ -483,12 +732,17 @@ void Solver::analyzeFinal(Lit p, LSet& out_conflict)
 }
 
 
-void Solver::uncheckedEnqueue(Lit p, CRef from)
+void Solver::uncheckedEnqueue(Lit p, int level, CRef from, Lit bin)
 {
     assert(value(p) == l_Undef);
+    assert(level <= decisionLevel());
     assigns[var(p)] = lbool(!sign(p));
-    vardata[var(p)] = mkVarData(from, decisionLevel());
+    vardata[var(p)] = mkVarData(from, level, bin);
     trail.push_(p);
+    if (heuristic == branch_lrb){
+        LrbData& l = lrb[var(p)];
+        l.assigned = conflicts;
+        l.participated = l.reasoned = 0; }
 }
 
 
@@ -498,21 +752,45 @@ void Solver::uncheckedEnqueue(Lit p, CRef from)
 |  
 |  Description:
 |    Propagates all enqueued facts. If a conflict arises, the conflicting clause is returned,
-|    otherwise CRef_Undef.
+|    otherwise CRef_Undef. Binary clauses are propagated from 'watches_bin' first, without ever
+|    looking at the clause itself. XOR, cardinality and linear constraints come last (see
+|    'gaussPropagate()', 'cardPropagate()' and 'linearPropagate()').
 |  
 |    Post-conditions:
 |      * the propagation queue is empty, even if there was a conflict.
+|  
+|    NOTE: after chronological backtracking, 'p' may be assigned below the current decision level.
+|    Implied literals then get the highest level among the other literals of their reason, which
+|    is made the second watch so that it stays false as long as the implied literal is true.
 |________________________________________________________________________________________________@*/
 CRef Solver::propagate()
 {
     CRef    confl     = CRef_Undef;
     int     num_props = 0;
 
+    if (lazy_sweep)
+        lazySweep();
+
     while (qhead < trail.size()){
         Lit            p   = trail[qhead++];     // 'p' is enqueued fact to propagate.
+        int            lev = level(var(p));
+        vec<Watcher>&  wbin = watches_bin.lookup(p);
+        num_props++;
+
+        // Propagate binary clauses:
+        for (int k = 0; k < wbin.size(); k++){
+            Lit imp = wbin[k].blocker;
+            if (value(imp) == l_False){
+                confl = wbin[k].cref;
+                qhead = trail.size();
+                break;
+            }else if (value(imp) == l_Undef)
+                uncheckedEnqueue(imp, lev, wbin[k].cref, ~p);
+        }
+        if (confl != CRef_Undef) break;
+
         vec<Watcher>&  ws  = watches.lookup(p);
         Watcher        *i, *j, *end;
-        num_props++;
 
         for (i = j = (Watcher*)ws, end = i + ws.size();  i != end;){
             // Try to avoid inspecting the clause:
@@ -550,12 +828,41 @@ CRef Solver::propagate()
                 // Copy the remaining watches:
                 while (i < end)
                     *j++ = *i++;
-            }else
-                uncheckedEnqueue(first, cr);
+            }else if (lev == decisionLevel())
+                uncheckedEnqueue(first, lev, cr);
+            else{
+                // Out-of-order propagation: watch the false literal with the highest level instead:
+                int max_k = 1, max_lev = lev;
+                for (int k = 2; k < c.size(); k++)
+                    if (level(var(c[k])) > max_lev){
+                        max_k   = k;
+                        max_lev = level(var(c[k])); }
+                if (max_k != 1){
+                    c[1] = c[max_k]; c[max_k] = false_lit;
+                    j--;
+                    watches[~c[1]].push(w); }
+                uncheckedEnqueue(first, max_lev, cr);
+            }
 
         NextClause:;
         }
         ws.shrink(i - j);
+
+        // Propagate XOR constraints:
+        if (confl == CRef_Undef && var(p) < xor_watches.size() && xor_watches[var(p)]->size() > 0){
+            confl = gaussPropagate(p);
+            if (confl != CRef_Undef)
+                qhead = trail.size(); }
+
+        // Propagate cardinality and linear constraints:
+        if (confl == CRef_Undef && toInt(p) < card_watches.size() && card_watches[toInt(p)]->size() > 0){
+            confl = cardPropagate(p);
+            if (confl != CRef_Undef)
+                qhead = trail.size(); }
+        if (confl == CRef_Undef && toInt(p) < lin_watches.size() && lin_watches[toInt(p)]->size() > 0){
+            confl = linearPropagate(p);
+            if (confl != CRef_Undef)
+                qhead = trail.size(); }
     }
     propagations += num_props;
     simpDB_props -= num_props;
@@ -566,200 +873,952 @@ CRef Solver::propagate()
 
 /*_________________________________________________________________________________________________
 |
-|  reduceDB : ()  ->  [void]
+|  conflictLevel : (confl : CRef) (forced : Lit&)  ->  [int]
 |  
 |  Description:
-|    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
-|    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|    Returns the highest decision level of the literals in the conflicting clause 'confl'. With
+|    chronological backtracking this may be below the current level. The two literals with the
+|    highest levels are made the watched ones, so that the clause is visited again once they are
+|    unassigned. If only a single literal is on the highest level, the clause is in fact a missed
+|    implication of it, and it is returned in 'forced' (otherwise 'lit_Undef').
 |________________________________________________________________________________________________@*/
-struct reduceDB_lt { 
-    ClauseAllocator& ca;
-    reduceDB_lt(ClauseAllocator& ca_) : ca(ca_) {}
-    bool operator () (CRef x, CRef y) { 
-        return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity()); } 
-};
-void Solver::reduceDB()
+int Solver::conflictLevel(CRef confl, Lit& forced)
 {
-    int     i, j;
-    double  extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
-
-    sort(learnts, reduceDB_lt(ca));
-    // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
-    // and clauses with activity smaller than 'extra_lim':
-    for (i = j = 0; i < learnts.size(); i++){
-        Clause& c = ca[learnts[i]];
-        if (c.size() > 2 && !locked(c) && (i < learnts.size() / 2 || c.activity() < extra_lim))
-            removeClause(learnts[i]);
-        else
-            learnts[j++] = learnts[i];
+    Clause& c = ca[confl];
+    Lit     w0 = c[0], w1 = c[1];
+
+    // Move the highest literal to 'c[0]' and the next highest to 'c[1]':
+    for (int k = 1; k < c.size(); k++)
+        if (level(var(c[k])) > level(var(c[0]))){
+            Lit tmp = c[0]; c[0] = c[k]; c[k] = tmp; }
+    for (int k = 2; k < c.size(); k++)
+        if (level(var(c[k])) > level(var(c[1]))){
+            Lit tmp = c[1]; c[1] = c[k]; c[k] = tmp; }
+
+    // Binary clauses are watched on both literals anyway, and lazy conflicts are not watched at all:
+    bool lazy_confl = lazy_clauses.size() > 0 && lazy_clauses.last() == confl;
+    if (c.size() > 2 && !lazy_confl && (c[0] != w0 || c[1] != w1) && (c[0] != w1 || c[1] != w0)){
+        remove(watches[~w0], Watcher(confl, w1));
+        remove(watches[~w1], Watcher(confl, w0));
+        watches[~c[0]].push(Watcher(confl, c[1]));
+        watches[~c[1]].push(Watcher(confl, c[0]));
     }
-    learnts.shrink(i - j);
-    checkGarbage();
+
+    int confl_level = level(var(c[0]));
+    forced = level(var(c[1])) < confl_level ? c[0] : lit_Undef;
+    return confl_level;
 }
 
 
-void Solver::removeSatisfied(vec<CRef>& cs)
+/*_________________________________________________________________________________________________
+|
+|  reuseTrail : ()  ->  [int]
+|  
+|  Description:
+|    Returns the decision level to restart to. The decisions of all levels up to it are more active
+|    than the next decision variable, so they would be picked again right after a full restart
+|    (with their saved phase), and the same literals would be propagated. Assumptions are always
+|    kept as well. A full restart is made while 'simplify()' has new top-level assignments to use,
+|    as it only runs at level 0.
+|________________________________________________________________________________________________@*/
+int Solver::reuseTrail()
 {
-    int i, j;
-    for (i = j = 0; i < cs.size(); i++){
-        Clause& c = ca[cs[i]];
-        if (satisfied(c))
-            removeClause(cs[i]);
-        else{
-            // Trim clause:
-            assert(value(c[0]) == l_Undef && value(c[1]) == l_Undef);
-            for (int k = 2; k < c.size(); k++)
-                if (value(c[k]) == l_False){
-                    c[k--] = c[c.size()-1];
-                    c.pop();
-                }
-            cs[j++] = cs[i];
-        }
+    int top = trail_lim.size() > 0 ? trail_lim[0] : trail.size();
+    if (top != simpDB_assigns && simpDB_props <= 0)
+        return 0;
+
+    int level = assumptions.size() < decisionLevel() ? assumptions.size() : decisionLevel();
+
+    if (heuristic == branch_vmtf){
+        Var next = vmtfNext();
+        if (next == var_Undef)
+            return decisionLevel();
+        while (level < decisionLevel() && vmtf[var(trail[trail_lim[level]])] > vmtf[next])
+            level++;
+        return level;
     }
-    cs.shrink(i - j);
+
+    // Find the next decision variable:
+    while (!order_heap.empty() && (value(order_heap[0]) != l_Undef || !decision[order_heap[0]]))
+        order_heap.removeMin();
+    if (order_heap.empty())
+        return decisionLevel();
+
+    double next = activity[order_heap[0]];
+    while (level < decisionLevel() && activity[var(trail[trail_lim[level]])] > next)
+        level++;
+    return level;
 }
 
 
-void Solver::rebuildOrderHeap()
+/*_________________________________________________________________________________________________
+|
+|  switchMode : ()  ->  [void]
+|  
+|  Description:
+|    Switch between a focused phase, with dynamic restarts, and a stable phase, with Luby restarts.
+|    Each phase has its own variable activities, the stable one starts out as a copy of the first
+|    focused phase. The decision heuristic may differ between the phases (see 'branch_stable').
+|    Phases are alternated after 'mode_first * n^2' conflicts (for the n:th pair).
+|________________________________________________________________________________________________@*/
+void Solver::switchMode()
 {
-    vec<Var> vs;
-    for (Var v = 0; v < nVars(); v++)
-        if (decision[v] && value(v) == l_Undef)
-            vs.push(v);
-    order_heap.build(vs);
+    // NOTE: the initial activities are kept for the stable phase if it uses LRB and the focused
+    // phase does not (or vice versa).
+    int stable = branch_stable >= 0 ? branch_stable : branching;
+    if (mode_switches == 0 && (stable == branch_lrb) == (branching == branch_lrb)){
+        activity.copyTo(mode_activity);
+        mode_var_inc = var_inc; }
+
+    VMap<double> tmp;
+    activity     .moveTo(tmp);
+    mode_activity.moveTo(activity);
+    tmp          .moveTo(mode_activity);
+    double inc   = var_inc;
+    var_inc      = mode_var_inc;
+    mode_var_inc = inc;
+
+    focused = !focused;
+    setHeuristic(phaseHeuristic());
+    mode_switches++;
+    uint64_t n = mode_switches / 2 + 1;
+    mode_limit = conflicts + mode_first * n * n;
 }
 
 
 /*_________________________________________________________________________________________________
 |
-|  simplify : [void]  ->  [bool]
+|  setHeuristic : (h : int)  ->  [void]
 |  
 |  Description:
-|    Simplify the clause database according to the current top-level assigment. Currently, the only
-|    thing done here is the removal of satisfied clauses, but more things can be put here.
+|    Change the decision heuristic, also in the middle of a search. Only the structure of the
+|    heuristic in use is kept up-to-date, so it is rebuilt here. VSIDS and LRB both order the
+|    variables by 'activity' (with different meanings, so alternating phases keep them apart).
 |________________________________________________________________________________________________@*/
-bool Solver::simplify()
+void Solver::setHeuristic(int h)
 {
-    assert(decisionLevel() == 0);
+    if (h == branch_lrb && heuristic != branch_lrb)
+        // Start new LRB intervals for all variables:
+        for (Var v = 0; v < nVars(); v++){
+            lrb[v].assigned     = lrb[v].canceled = conflicts;
+            lrb[v].participated = lrb[v].reasoned = 0; }
 
-    if (!ok || propagate() != CRef_Undef)
-        return ok = false;
+    heuristic = h;
+    rebuildOrderHeap();
+}
 
-    if (nAssigns() == simpDB_assigns || (simpDB_props > 0))
-        return true;
 
-    // Remove satisfied clauses:
-    removeSatisfied(learnts);
-    if (remove_satisfied){       // Can be turned off.
-        removeSatisfied(clauses);
+/*_________________________________________________________________________________________________
+|
+|  lrbUnassign : (x : Var)  ->  [void]
+|  
+|  Description:
+|    Learning rate based branching (Liang et al.) treats each variable as an arm of a bandit. When
+|    a variable is unassigned, its reward is the fraction of conflicts since its assignment it took
+|    part in (or was reason side of), and its activity moves towards it by the current step size.
+|________________________________________________________________________________________________@*/
+void Solver::lrbUnassign(Var x)
+{
+    LrbData& l        = lrb[x];
+    uint64_t interval = conflicts - l.assigned;
+    if (interval > 0){
+        double reward = (double)(l.participated + l.reasoned) / interval;
+        activity[x]   = (1 - lrb_step) * activity[x] + lrb_step * reward;
+        if (order_heap.inHeap(x))
+            order_heap.update(x);
+    }
+    l.canceled = conflicts;
+}
 
-        // TODO: what todo in if 'remove_satisfied' is false?
 
-        // Remove all released variables from the trail:
-        for (int i = 0; i < released_vars.size(); i++){
-            assert(seen[released_vars[i]] == 0);
-            seen[released_vars[i]] = 1;
+// LRB: count the variables in the reasons of a learnt clause that did not take part in the
+// conflict themselves. Uses 'seen', which must still be set for the conflict's variables.
+void Solver::lrbReasoned(const vec<Lit>& learnt)
+{
+    seen[var(learnt[0])] = 1;
+    for (int i = 0; i < learnt.size(); i++){
+        CRef cr = reason(var(learnt[i]));
+        if (cr == CRef_Undef) continue;
+
+        const Clause& c = ca[cr];
+        for (int k = 0; k < c.size(); k++){
+            Var x = var(c[k]);
+            if (!seen[x] && level(x) > 0){
+                seen[x] = 1;
+                lrb[x].reasoned++;
+                analyze_toclear.push(c[k]); }
         }
+    }
+}
 
-        int i, j;
-        for (i = j = 0; i < trail.size(); i++)
-            if (seen[var(trail[i])] == 0)
-                trail[j++] = trail[i];
-        trail.shrink(i - j);
-        //printf("trail.size()= %d, qhead = %d\n", trail.size(), qhead);
-        qhead = trail.size();
 
-        for (int i = 0; i < released_vars.size(); i++)
-            seen[released_vars[i]] = 0;
+// Remember the first 'consistent' literals of the trail, which are known to be conflict free, as
+// target and best phase if they are the longest such assignment so far.
+void Solver::updatePhases(int consistent)
+{
+    if (useTarget() && consistent > target_assigned){
+        for (int i = 0; i < consistent; i++)
+            target_phase[var(trail[i])] = sign(trail[i]);
+        target_assigned = consistent; }
+
+    if (consistent > best_assigned){
+        for (int i = 0; i < consistent; i++)
+            best_phase[var(trail[i])] = sign(trail[i]);
+        best_assigned = consistent; }
+}
 
-        // Released variables are now ready to be reused:
-        append(released_vars, free_vars);
-        released_vars.clear();
+
+/*_________________________________________________________________________________________________
+|
+|  rephase : ()  ->  [void]
+|  
+|  Description:
+|    Overwrite the saved phases to move the search to a different part of the search space. The
+|    first two times with the original and the inverted phases, after that alternating between the
+|    best phase and those two (B O B I B O ...), or, with local search, between the best phase, the
+|    result of a local search and those two (B W O B W I ...). The target phase starts over from
+|    the new phases.
+|________________________________________________________________________________________________@*/
+void Solver::rephase()
+{
+    enum { original, inverted, best, walked };
+    static const int schedule     [] = { best, original, best, inverted };
+    static const int walk_schedule[] = { best, walked, original, best, walked, inverted };
+    int kind = rephases < 2      ? (int)rephases
+             : walk_flips > 0    ? walk_schedule[(rephases - 2) % 6]
+             :                     schedule[(rephases - 2) % 4];
+
+    if (kind == walked)
+        walk();
+    else
+        for (Var v = 0; v < nVars(); v++)
+            polarity[v] = kind == original ? true : kind == inverted ? false : best_phase[v];
+    if (kind == best)
+        best_assigned = 0;
+    polarity.copyTo(target_phase);
+    target_assigned = 0;
+
+    rephases++;
+    rephase_limit = conflicts + (uint64_t)rephase_first * (rephases + 1);
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  walk : ()  ->  [void]
+|  
+|  Description:
+|    Run a local search on the original clauses, starting from the saved phases, and save the
+|    assignment with the fewest falsified clauses as phases. Only top-level assignments are taken
+|    into account, so it may be called at any decision level.
+|________________________________________________________________________________________________@*/
+void Solver::walk()
+{
+    Walker walker(nVars(), random_seed);
+
+    for (int i = 0; i < clauses.size(); i++){
+        const Clause& c = ca[clauses[i]];
+        if (c.mark() == 1) continue;
+
+        bool sat = false;
+        add_tmp.clear();
+        for (int j = 0; j < c.size() && !sat; j++)
+            if (value(c[j]) == l_Undef || level(var(c[j])) > 0)
+                add_tmp.push(c[j]);
+            else
+                sat = value(c[j]) == l_True;
+        if (!sat)
+            walker.addClause(add_tmp);
     }
-    checkGarbage();
-    rebuildOrderHeap();
 
-    simpDB_assigns = nAssigns();
-    simpDB_props   = clauses_literals + learnts_literals;   // (shouldn't depend on stats really, but it will do for now)
+    for (Var v = 0; v < nVars(); v++)
+        walker.setPhase(v, polarity[v]);
 
-    return true;
+    walks++;
+    walker.walk((uint64_t)walk_flips * walks);
+    walk_flipped += walker.flips;
+
+    for (Var v = 0; v < nVars(); v++)
+        polarity[v] = walker.phase(v);
 }
 
 
 /*_________________________________________________________________________________________________
 |
-|  search : (nof_conflicts : int) (params : const SearchParams&)  ->  [lbool]
+|  inprocess : ()  ->  [bool]
 |  
 |  Description:
-|    Search for a model the specified number of conflicts. 
-|    NOTE! Use negative value for 'nof_conflicts' indicate infinity.
+|    Simplify the clause database at level 0 between restarts. Each technique gets a budget of
+|    ticks proportional to the propagations of the search since the previous round. Returns FALSE
+|    if the clauses are found unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Solver::inprocess()
+{
+    assert(decisionLevel() == 0);
+    uint64_t ticks = (uint64_t)((propagations - inprocess_props) * inprocess_effort);
+
+    inprocessings++;
+    if (!simplify() || (use_probe && !probe(ticks)) || (use_vivify && !vivifyLearnts(ticks)) || !inprocessSimp(ticks))
+        return false;
+
+    inprocess_props = propagations;
+    inprocess_limit = conflicts + (uint64_t)inprocess_first * (inprocessings + 1);
+    return true;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  vivify : (cr : CRef)  ->  [bool]
 |  
-|  Output:
-|    'l_True' if a partial assigment that is consistent with respect to the clauseset is found. If
-|    all variables are decision variables, this means that the clause set is satisfiable. 'l_False'
-|    if the clause set is unsatisfiable. 'l_Undef' if the bound on number of conflicts is reached.
+|  Description:
+|    Assign the literals of the clause to false one by one at a temporary decision level and
+|    propagate. On a conflict, the literals assigned so far already form a clause, and a literal
+|    found true ends it. Literals found false can be left out. The clause is replaced if this makes
+|    it shorter. Must be called at level 0. Returns FALSE if a conflict was found at level 0.
 |________________________________________________________________________________________________@*/
-lbool Solver::search(int nof_conflicts)
+bool Solver::vivify(CRef cr)
 {
-    assert(ok);
-    int         backtrack_level;
-    int         conflictC = 0;
-    vec<Lit>    learnt_clause;
-    starts++;
+    assert(decisionLevel() == 0);
+    if (ca[cr].mark() == 1 || satisfied(ca[cr]))
+        return true;
 
-    for (;;){
-        CRef confl = propagate();
+    // NOTE: propagation may reorder the literals of the clause itself, so they are copied first.
+    vec<Lit> lits, kept;
+    for (int i = 0; i < ca[cr].size(); i++)
+        lits.push(ca[cr][i]);
+
+    CRef confl   = CRef_Undef;
+    Lit  implied = lit_Undef;
+    newDecisionLevel();
+    for (int i = 0; i < lits.size() && confl == CRef_Undef; i++)
+        if (value(lits[i]) == l_True){
+            implied = lits[i];
+            kept.push(implied);
+            break;
+        }else if (value(lits[i]) == l_Undef){
+            kept.push(lits[i]);
+            uncheckedEnqueue(~lits[i]);
+            confl = propagate();
+        }
+
+    if (kept.size() == lits.size()){
+        cancelUntil(0, false);
+        return true; }
+
+    // All literals false means the clause itself is the conflict:
+    if (confl == CRef_Undef && implied == lit_Undef)
+        confl = cr;
+
+    uint64_t id = 0;
+    if (proof != NULL){
+        proofChain(confl != CRef_Undef ? confl : reason(var(implied)), kept, proof_hints);
+        proofUnits();
+        id = proofAdd(kept, proof_hints); }
+    cancelUntil(0, false);
+
+    vivified_clauses++;
+    vivified_lits += lits.size() - kept.size();
+
+    if (kept.size() == 1){
+        removeClause(cr);
+        unit_id[var(kept[0])] = id;
+        uncheckedEnqueue(kept[0]);
+        confl = propagate();
         if (confl != CRef_Undef){
-            // CONFLICT
-            conflicts++; conflictC++;
-            if (decisionLevel() == 0) return l_False;
+            proofEmpty(confl);
+            return ok = false; }
+        return true;
+    }
 
-            learnt_clause.clear();
-            analyze(confl, learnt_clause, backtrack_level);
-            cancelUntil(backtrack_level);
+    Clause& c = ca[cr];
+    detachClause(cr, true);
+    if (proof != NULL) proofDelete(c);
+    for (int i = 0; i < kept.size(); i++)
+        c[i] = kept[i];
+    c.shrink(c.size() - kept.size());
+    if (c.has_id()) c.id(id);
+    if (c.learnt() && c.lbd() > (uint32_t)kept.size()){
+        c.lbd(kept.size());
+        c.tier(lbdTier(kept.size())); }
+    attachClause(cr);
 
-            if (learnt_clause.size() == 1){
-                uncheckedEnqueue(learnt_clause[0]);
-            }else{
-                CRef cr = ca.alloc(learnt_clause, true);
-                learnts.push(cr);
-                attachClause(cr);
-                claBumpActivity(ca[cr]);
-                uncheckedEnqueue(learnt_clause[0], cr);
-            }
+    return true;
+}
 
-            varDecayActivity();
-            claDecayActivity();
 
-            if (--learntsize_adjust_cnt == 0){
-                learntsize_adjust_confl *= learntsize_adjust_inc;
-                learntsize_adjust_cnt    = (int)learntsize_adjust_confl;
-                max_learnts             *= learntsize_inc;
+/*_________________________________________________________________________________________________
+|
+|  probeLit : (p : Lit)  ->  [CRef]
+|  
+|  Description:
+|    Assign 'p' at a new decision level 1 and propagate. Returns the conflicting clause, if any.
+|    Otherwise, every literal implied through a long clause gets a hyper-binary resolvent: a binary
+|    clause with the negation of its dominator, the closest literal through which all its
+|    implications from 'p' pass. The resolvent becomes its reason, so that the implications of
+|    level 1 form a tree of binary clauses.
+|________________________________________________________________________________________________@*/
+CRef Solver::probeLit(Lit p)
+{
+    assert(decisionLevel() == 0);
+    newDecisionLevel();
+    uncheckedEnqueue(p);
+    CRef confl = propagate();
+    if (confl != CRef_Undef)
+        return confl;
+
+    vec<Var>  marked;
+    vec<Lit>& hbr = add_tmp;
+    for (int i = trail_lim[0] + 1; i < trail.size(); i++){
+        Lit q = trail[i];
+        CRef r = reason(var(q));
+        if (level(var(q)) != 1 || ca[r].size() == 2) continue;
+
+        // The dominator of the false literals of the reason, found by walking up the tree:
+        Lit dom = lit_Undef;
+        const Clause& c = ca[r];
+        for (int j = 0; j < c.size(); j++){
+            Lit a = ~c[j];
+            if (var(a) == var(q) || level(var(a)) == 0) continue;
+            if (dom == lit_Undef){
+                dom = a;
+                continue; }
 
-                if (verbosity >= 1)
-                    printf("| %9d | %7d %8d %8d | %8d %8d %6.0f | %6.3f %% |\n", 
-                           (int)conflicts, 
-                           (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]), nClauses(), (int)clauses_literals, 
-                           (int)max_learnts, nLearnts(), (double)learnts_literals/nLearnts(), progressEstimate()*100);
-            }
+            // Mark the path from 'dom' to the root, and find its first marked literal above 'a':
+            for (Lit b = dom;; b = ~binReason(var(b))){
+                seen[var(b)] = 1;
+                marked.push(var(b));
+                if (b == p) break; }
+            while (!seen[var(a)])
+                a = ~binReason(var(a));
+            dom = a;
+            for (int k = 0; k < marked.size(); k++)
+                seen[marked[k]] = 0;
+            marked.clear();
+        }
 
-        }else{
-            // NO CONFLICT
-            if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget()){
-                // Reached bound on number of conflicts:
-                progress_estimate = progressEstimate();
-                cancelUntil(0);
-                return l_Undef; }
+        hbr.clear();
+        hbr.push(q);
+        hbr.push(~dom);
+        CRef cr = ca.alloc(hbr, true);
+        if (proof != NULL){
+            proofChain(r, hbr, proof_hints);
+            proofUnits();
+            uint64_t id = proofAdd(hbr, proof_hints);
+            if (ca[cr].has_id()) ca[cr].id(id); }
+        ca[cr].lbd(2);
+        ca[cr].tier(tier_mid);          // (not 'core': kept only while used in conflicts)
+        learnts.push(cr);
+        attachClause(cr);
+        vardata[var(q)].reason = cr;
+        vardata[var(q)].bin    = ~dom;
+        hbr_clauses++;
+    }
 
-            // Simplify the set of problem clauses:
-            if (decisionLevel() == 0 && !simplify())
-                return l_False;
+    return CRef_Undef;
+}
 
-            if (learnts.size()-nAssigns() >= max_learnts)
-                // Reduce the set of learnt clauses:
-                reduceDB();
 
-            Lit next = lit_Undef;
+bool Solver::failedLit(Lit p, CRef confl)
+{
+    vec<Lit> unit;
+    unit.push(~p);
+    uint64_t id = 0;
+    if (proof != NULL){
+        proofChain(confl, unit, proof_hints);
+        proofUnits();
+        id = proofAdd(unit, proof_hints); }
+    cancelUntil(0, false);
+
+    failed_lits++;
+    unit_id[var(p)] = id;
+    uncheckedEnqueue(~p);
+    confl = propagate();
+    if (confl != CRef_Undef){
+        proofEmpty(confl);
+        return ok = false; }
+    return true;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  probe : (ticks : uint64_t)  ->  [bool]
+|  
+|  Description:
+|    Probe both polarities of the variables of the roots of the binary implication graph (literals
+|    with outgoing but no incoming binary implications), continuing where the previous round
+|    stopped, until 'ticks' propagations are used. A polarity that leads to a conflict is a failed
+|    literal and its negation holds. Literals implied by both polarities hold as well. Must be
+|    called at level 0. Returns FALSE if a conflict was found at level 0.
+|________________________________________________________________________________________________@*/
+bool Solver::probe(uint64_t ticks)
+{
+    assert(decisionLevel() == 0);
+    if (nVars() == 0) return true;
+
+    vec<Lit> roots;
+    for (int k = 0; k < nVars(); k++){
+        Var v = (probe_next + k) % nVars();
+        if (value(v) != l_Undef || !decision[v]) continue;
+        for (int s = 0; s < 2; s++){
+            Lit p = mkLit(v, s);
+            if (watches_bin.lookup(p).size() > 0 && watches_bin.lookup(~p).size() == 0)
+                roots.push(p); }
+    }
+
+    uint64_t limit = propagations + ticks;
+    vec<Lit> implied;
+    vec<uint64_t> ids;
+    for (int i = 0; i < roots.size() && propagations < limit; i++){
+        Lit p = roots[i];
+        probe_next = (var(p) + 1) % nVars();
+        if (value(p) != l_Undef) continue;
+        probes++;
+
+        CRef confl = probeLit(p);
+        if (confl != CRef_Undef){
+            if (!failedLit(p, confl)) return false;
+            continue; }
+        implied.clear();
+        for (int j = trail_lim[0] + 1; j < trail.size(); j++)
+            implied.push(trail[j]);
+        cancelUntil(0, false);
+
+        confl = probeLit(~p);
+        if (confl != CRef_Undef){
+            if (!failedLit(~p, confl)) return false;
+            continue; }
+
+        // Lift the literals implied by both polarities:
+        int j, k;
+        for (j = k = 0; j < implied.size(); j++)
+            if (value(implied[j]) == l_True && level(var(implied[j])) == 1)
+                implied[k++] = implied[j];
+        implied.shrink(j - k);
+        if (implied.size() == 0){
+            cancelUntil(0, false);
+            continue; }
+
+        // NOTE: a proof gets the binary clauses '(p | q)' and '(~p | q)' for each lifted literal 'q',
+        // the second ones by propagating 'p' once more.
+        ids.clear();
+        if (proof != NULL){
+            for (j = 0; j < implied.size(); j++){
+                vec<Lit> bin;
+                bin.push(p);
+                bin.push(implied[j]);
+                proofChain(reason(var(implied[j])), bin, proof_hints);
+                proofUnits();
+                ids.push(proofAdd(bin, proof_hints)); }
+            cancelUntil(0, false);
+
+            newDecisionLevel();
+            uncheckedEnqueue(p);
+            confl = propagate();
+            if (confl != CRef_Undef){
+                if (!failedLit(p, confl)) return false;
+                continue; }
+            for (j = 0; j < implied.size(); j++){
+                vec<Lit> bin;
+                bin.push(~p);
+                bin.push(implied[j]);
+                proofChain(reason(var(implied[j])), bin, proof_hints);
+                proofUnits();
+                ids.push(proofAdd(bin, proof_hints)); }
+        }
+        cancelUntil(0, false);
+
+        for (j = 0; j < implied.size(); j++){
+            Lit q = implied[j];
+            lifted_lits++;
+            unit_id[var(q)] = 0;
+            if (proof != NULL){
+                vec<Lit> unit, bin;
+                unit.push(q);
+                proof_hints.clear();
+                if (lrat()){
+                    proof_hints.push(ids[j]);
+                    proof_hints.push(ids[implied.size() + j]); }
+                unit_id[var(q)] = proofAdd(unit, proof_hints);
+                bin.push(p);  bin.push(q); proof->remove(ids[j], (const Lit*)bin, bin.size());
+                bin[0] = ~p;  proof->remove(ids[implied.size() + j], (const Lit*)bin, bin.size());
+            }
+            uncheckedEnqueue(q);
+        }
+        confl = propagate();
+        if (confl != CRef_Undef){
+            proofEmpty(confl);
+            return ok = false; }
+    }
+
+    return true;
+}
+
+
+struct vivify_lt {
+    ClauseAllocator& ca;
+    vivify_lt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) { 
+        return ca[x].lbd() < ca[y].lbd() || (ca[x].lbd() == ca[y].lbd() && ca[x].size() < ca[y].size()); } 
+};
+
+// Vivify the core and mid tier learnt clauses that have not been vivified before, those with the
+// lowest LBD first, until 'ticks' propagations are used:
+bool Solver::vivifyLearnts(uint64_t ticks)
+{
+    vec<CRef> cands;
+    for (int i = 0; i < learnts.size(); i++){
+        Clause& c = ca[learnts[i]];
+        if (c.tier() != tier_local && !c.vivified())
+            cands.push(learnts[i]); }
+    sort(cands, vivify_lt(ca));
+
+    uint64_t limit  = propagations + ticks;
+    bool     result = true;
+    for (int i = 0; i < cands.size() && propagations < limit && result; i++){
+        if (ca[cands[i]].mark() == 1) continue;
+        ca[cands[i]].vivified(true);
+        result = vivify(cands[i]);
+    }
+
+    int i, j;
+    for (i = j = 0; i < learnts.size(); i++)
+        if (ca[learnts[i]].mark() != 1)
+            learnts[j++] = learnts[i];
+    learnts.shrink(i - j);
+    countKept();
+
+    return result;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  reduceDB : ()  ->  [void]
+|  
+|  Description:
+|    Learnt clauses are kept in three tiers depending on their LBD (literal block distance). Core
+|    clauses are never removed. Mid tier clauses are kept as long as they have been used in conflict
+|    analysis since the last call, otherwise they are moved to the local tier. Of the local tier,
+|    half of the clauses are removed, minus the clauses locked by the current assignment. Locked
+|    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|________________________________________________________________________________________________@*/
+struct reduceDB_lt { 
+    ClauseAllocator& ca;
+    reduceDB_lt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) { 
+        return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity()); } 
+};
+void Solver::reduceDB()
+{
+    int       i, j;
+    vec<CRef> local;
+
+    // Keep the core and the used part of the mid tier, collect the local tier:
+    for (i = j = 0; i < learnts.size(); i++){
+        Clause& c = ca[learnts[i]];
+        if (c.tier() == tier_mid && !c.used())
+            c.tier(tier_local);
+
+        if (c.tier() == tier_local)
+            local.push(learnts[i]);
+        else
+            learnts[j++] = learnts[i];
+        c.used(false);
+    }
+    learnts.shrink(i - j);
+    kept_learnts = learnts.size();
+
+    double  extra_lim = cla_inc / local.size();      // Remove any clause below this activity
+
+    sort(local, reduceDB_lt(ca));
+    // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
+    // and clauses with activity smaller than 'extra_lim':
+    for (i = 0; i < local.size(); i++){
+        Clause& c = ca[local[i]];
+        if (c.size() > 2 && !locked(c) && (i < local.size() / 2 || c.activity() < extra_lim))
+            removeClause(local[i]);
+        else
+            learnts.push(local[i]);
+    }
+    checkGarbage();
+}
+
+
+// Learnts removed outside 'reduceDB()' must not be counted as kept, or the next reduction would be
+// postponed by their number:
+void Solver::countKept()
+{
+    kept_learnts = 0;
+    for (int i = 0; i < learnts.size(); i++)
+        if (ca[learnts[i]].tier() != tier_local)
+            kept_learnts++;
+}
+
+
+void Solver::removeSatisfied(vec<CRef>& cs)
+{
+    int i, j;
+    for (i = j = 0; i < cs.size(); i++){
+        Clause& c = ca[cs[i]];
+        if (satisfied(c))
+            removeClause(cs[i]);
+        else{
+            // Trim clause:
+            assert(value(c[0]) == l_Undef && value(c[1]) == l_Undef);
+            int      sz = c.size();
+            uint64_t id = 0;
+            if (proof != NULL){
+                // Log the trimmed clause before the original is deleted:
+                add_tmp.clear();
+                proof_hints.clear();
+                for (int k = 0; k < c.size(); k++)
+                    if (value(c[k]) != l_False)
+                        add_tmp.push(c[k]);
+                    else if (lrat())
+                        proof_hints.push(unit_id[var(c[k])]);
+                if (add_tmp.size() < sz){
+                    if (lrat()) proof_hints.push(c.id());
+                    id = proofAdd(add_tmp, proof_hints);
+                    proofDelete(c); }
+            }
+            for (int k = 2; k < c.size(); k++)
+                if (value(c[k]) == l_False){
+                    c[k--] = c[c.size()-1];
+                    c.pop();
+                }
+            if (id != 0 && c.has_id())
+                c.id(id);
+
+            // Move clauses that became binary to the binary watcher lists:
+            if (sz > 2 && c.size() == 2){
+                remove(watches[~c[0]], Watcher(cs[i], c[1]));
+                remove(watches[~c[1]], Watcher(cs[i], c[0]));
+                watches_bin[~c[0]].push(Watcher(cs[i], c[1]));
+                watches_bin[~c[1]].push(Watcher(cs[i], c[0]));
+            }
+            cs[j++] = cs[i];
+        }
+    }
+    cs.shrink(i - j);
+}
+
+
+void Solver::rebuildOrderHeap()
+{
+    if (heuristic == branch_vmtf){
+        // The queue itself is always up-to-date, only the search position is lost:
+        vmtf.reset();
+        return; }
+
+    vec<Var> vs;
+    for (Var v = 0; v < nVars(); v++)
+        if (decision[v] && value(v) == l_Undef)
+            vs.push(v);
+    order_heap.build(vs);
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  simplify : [void]  ->  [bool]
+|  
+|  Description:
+|    Simplify the clause database according to the current top-level assigment. Currently, the only
+|    thing done here is the removal of satisfied clauses, but more things can be put here.
+|________________________________________________________________________________________________@*/
+bool Solver::simplify()
+{
+    assert(decisionLevel() == 0);
+
+    if (!ok)
+        return false;
+
+    CRef confl = propagate();
+    if (confl != CRef_Undef){
+        proofEmpty(confl);
+        return ok = false; }
+
+    // Set up new XOR constraints right away:
+    if (xor_ends.size() > 0 && !gaussBuild())
+        return false;
+
+    if (nAssigns() == simpDB_assigns || (simpDB_props > 0))
+        return true;
+
+    proofUnits();
+
+    // Remove the top-level assignments from the XOR, cardinality and linear constraints (before
+    // released variables are reused):
+    if (!gaussBuild() || !cardSimplify() || !linearSimplify())
+        return false;
+
+    // Remove satisfied clauses:
+    removeSatisfied(learnts);
+    countKept();
+    if (remove_satisfied){       // Can be turned off.
+        removeSatisfied(clauses);
+
+        // TODO: what todo in if 'remove_satisfied' is false?
+
+        // Remove all released variables from the trail:
+        for (int i = 0; i < released_vars.size(); i++){
+            assert(seen[released_vars[i]] == 0);
+            seen[released_vars[i]] = 1;
+        }
+
+        int i, j;
+        for (i = j = 0; i < trail.size(); i++)
+            if (seen[var(trail[i])] == 0)
+                trail[j++] = trail[i];
+        trail.shrink(i - j);
+        //printf("trail.size()= %d, qhead = %d\n", trail.size(), qhead);
+        qhead = trail.size();
+        if (proof_units > trail.size())
+            proof_units = trail.size();
+
+        for (int i = 0; i < released_vars.size(); i++)
+            seen[released_vars[i]] = 0;
+
+        // Released variables are now ready to be reused:
+        append(released_vars, free_vars);
+        released_vars.clear();
+    }
+    checkGarbage();
+    rebuildOrderHeap();
+
+    simpDB_assigns = nAssigns();
+    simpDB_props   = clauses_literals + learnts_literals;   // (shouldn't depend on stats really, but it will do for now)
+
+    return true;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  search : (nof_conflicts : int) (params : const SearchParams&)  ->  [lbool]
+|  
+|  Description:
+|    Search for a model the specified number of conflicts. 
+|    NOTE! Use negative value for 'nof_conflicts' indicate infinity.
+|  
+|  Output:
+|    'l_True' if a partial assigment that is consistent with respect to the clauseset is found. If
+|    all variables are decision variables, this means that the clause set is satisfiable. 'l_False'
+|    if the clause set is unsatisfiable. 'l_Undef' if the bound on number of conflicts is reached.
+|________________________________________________________________________________________________@*/
+lbool Solver::search(int nof_conflicts)
+{
+    assert(ok);
+    int         backtrack_level;
+    uint32_t    learnt_lbd;
+    uint64_t    learnt_id = 0;
+    int         conflictC = 0;
+    int         min_conflictC = 50;    // (no dynamic restart before this many conflicts)
+    vec<Lit>    learnt_clause;
+    starts++;
+
+    for (;;){
+        CRef confl = propagate();
+        if (confl != CRef_Undef){
+            // CONFLICT
+            conflicts++; conflictC++;
+
+            // Block dynamic restarts while the trail is much longer than usual (the solver may be
+            // getting close to a model):
+            if (focused && conflicts > 10000 && conflictC >= min_conflictC && trail.size() > restart_block * trail_avg.value){
+                blocked_restarts++;
+                min_conflictC = conflictC + 50; }
+            trail_avg.update(trail.size());
+            int  confl_level = decisionLevel();
+            bool lazy_confl  = lazy_clauses.size() > 0 && lazy_clauses.last() == confl;
+            if ((chronoBT() || lazy_confl) && confl_level > 0){
+                // After chronological backtracking (or lazy propagation) the conflict may be on a lower level:
+                Lit forced;
+                confl_level = conflictLevel(confl, forced);
+                if (confl_level > 0 && forced != lit_Undef){
+                    // Only one literal on the conflict level -- assign it as implied instead:
+                    const Clause& c = ca[confl];
+                    cancelUntil(confl_level - 1);
+                    uncheckedEnqueue(c[0], level(var(c[1])), confl, c.size() == 2 ? c[1] : lit_Undef);
+                    continue; }
+                cancelUntil(confl_level);
+            }
+            if (confl_level == 0){
+                proofEmpty(confl);
+                return l_False; }
+
+            // The assignment below the conflict level is conflict free:
+            updatePhases(trail_lim.last());
+
+            learnt_clause.clear();
+            analyze(confl, learnt_clause, backtrack_level, learnt_lbd);
+            lbd_fast.update(learnt_lbd);
+            lbd_slow.update(learnt_lbd);
+            if (proof != NULL){
+                proofChain(confl, learnt_clause, proof_hints);
+                learnt_id = proofAdd(learnt_clause, proof_hints); }
+            if (chronoBT() && decisionLevel() - backtrack_level > chrono){
+                chrono_backtracks++;
+                cancelUntil(decisionLevel() - 1);
+            }else
+                cancelUntil(backtrack_level);
+            exportLearnt(learnt_clause, learnt_lbd);
+
+            if (learnt_clause.size() == 1){
+                unit_id[var(learnt_clause[0])] = learnt_id;
+                uncheckedEnqueue(learnt_clause[0], 0, CRef_Undef);
+            }else{
+                CRef cr = ca.alloc(learnt_clause, true);
+                if (ca[cr].has_id()) ca[cr].id(learnt_id);
+                ca[cr].lbd(learnt_lbd);
+                ca[cr].tier(lbdTier(learnt_lbd));
+                learnts.push(cr);
+                attachClause(cr);
+                claBumpActivity(ca[cr]);
+                uncheckedEnqueue(learnt_clause[0], backtrack_level, cr);
+            }
+
+            varDecayActivity();
+            claDecayActivity();
+
+            if (--learntsize_adjust_cnt == 0){
+                learntsize_adjust_confl *= learntsize_adjust_inc;
+                learntsize_adjust_cnt    = (int)learntsize_adjust_confl;
+                max_learnts             *= learntsize_inc;
+
+                if (verbosity >= 1)
+                    printf("| %9d | %7d %8d %8d | %8d %8d %6.0f | %6.3f %% |\n", 
+                           (int)conflicts, 
+                           (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]), nClauses(), (int)clauses_literals, 
+                           (int)max_learnts, nLearnts(), (double)learnts_literals/nLearnts(), progressEstimate()*100);
+            }
+
+        }else{
+            // NO CONFLICT
+            bool restart = focused ? conflictC >= min_conflictC && lbd_fast.value > restart_margin * lbd_slow.value
+                                   : nof_conflicts >= 0 && conflictC >= nof_conflicts;
+            if (restart || !withinBudget()){
+                // Reached bound on number of conflicts:
+                progress_estimate = progressEstimate();
+                updatePhases(trail.size());
+                cancelUntil(reuse_trail ? reuseTrail() : 0);
+                return l_Undef; }
+
+            // Simplify the set of problem clauses:
+            if (decisionLevel() == 0 && !simplify())
+                return l_False;
+
+            // Attach clauses learnt elsewhere:
+            if (decisionLevel() == 0 && !importLearnts())
+                return l_False;
+
+            if (learnts.size()-kept_learnts-nAssigns() >= max_learnts)
+                // Reduce the set of learnt clauses:
+                reduceDB();
+
+            Lit next = lit_Undef;
             while (decisionLevel() < assumptions.size()){
                 // Perform user provided assumption:
                 Lit p = assumptions[decisionLevel()];
@@ -775,141 +1834,1018 @@ lbool Solver::search(int nof_conflicts)
                 }
             }
 
-            if (next == lit_Undef){
-                // New variable decision:
-                decisions++;
-                next = pickBranchLit();
+            if (next == lit_Undef){
+                // New variable decision:
+                decisions++;
+                next = pickBranchLit();
+
+                if (next == lit_Undef)
+                    // Model found:
+                    return l_True;
+            }
+
+            // Increase decision level and enqueue 'next'
+            newDecisionLevel();
+            uncheckedEnqueue(next);
+        }
+    }
+}
+
+
+double Solver::progressEstimate() const
+{
+    double  progress = 0;
+    double  F = 1.0 / nVars();
+
+    for (int i = 0; i <= decisionLevel(); i++){
+        int beg = i == 0 ? 0 : trail_lim[i - 1];
+        int end = i == decisionLevel() ? trail.size() : trail_lim[i];
+        progress += pow(F, i) * (end - beg);
+    }
+
+    return progress / nVars();
+}
+
+/*
+  Finite subsequences of the Luby-sequence:
+
+  0: 1
+  1: 1 1 2
+  2: 1 1 2 1 1 2 4
+  3: 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8
+  ...
+
+
+ */
+
+static double luby(double y, int x){
+
+    // Find the finite subsequence that contains index 'x', and the
+    // size of that subsequence:
+    int size, seq;
+    for (size = 1, seq = 0; size < x+1; seq++, size = 2*size+1);
+
+    while (size-1 != x){
+        size = (size-1)>>1;
+        seq--;
+        x = x % size;
+    }
+
+    return pow(y, seq);
+}
+
+// NOTE: assumptions passed in member-variable 'assumptions'.
+lbool Solver::solve_()
+{
+    model.clear();
+    conflict.clear();
+    if (!ok) return l_False;
+
+    solves++;
+
+    max_learnts = nClauses() * learntsize_factor;
+    if (max_learnts < min_learnts_lim)
+        max_learnts = min_learnts_lim;
+
+    learntsize_adjust_confl   = learntsize_adjust_start_confl;
+    learntsize_adjust_cnt     = (int)learntsize_adjust_confl;
+    lbool   status            = l_Undef;
+
+    if (verbosity >= 1){
+        printf("============================[ Search Statistics ]==============================\n");
+        printf("| Conflicts |          ORIGINAL         |          LEARNT          | Progress |\n");
+        printf("|           |    Vars  Clauses Literals |    Limit  Clauses Lit/Cl |          |\n");
+        printf("===============================================================================\n");
+    }
+
+    if (restart_mode != 2)
+        focused = restart_mode == 1;
+    else if (mode_limit == 0){
+        focused    = true;
+        mode_limit = conflicts + mode_first; }
+    if (heuristic != phaseHeuristic())
+        setHeuristic(phaseHeuristic());
+    if (rephase_limit == 0)
+        rephase_limit = conflicts + rephase_first;
+    if (inprocess_limit == 0){
+        inprocess_limit = conflicts + inprocess_first;
+
+        // Probe once before the search, with a budget of about one pass over the clauses:
+        if (inprocess_first > 0 && use_probe && !probe(clauses_literals))
+            status = l_False;
+    }
+
+    // Search:
+    int curr_restarts = 0;
+    while (status == l_Undef){
+        if (focused)
+            status = search(-1);
+        else{
+            double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
+            status = search(rest_base * restart_first);
+            curr_restarts++;
+        }
+        if (!withinBudget()) break;
+
+        if (status == l_Undef && restart_mode == 2 && conflicts >= mode_limit)
+            switchMode();
+        if (status == l_Undef && rephase_first > 0 && conflicts >= rephase_limit)
+            rephase();
+        if (status == l_Undef && inprocess_first > 0 && conflicts >= inprocess_limit){
+            cancelUntil(0);
+            if (!inprocess())
+                status = l_False; }
+    }
+
+    if (verbosity >= 1)
+        printf("===============================================================================\n");
+
+
+    if (status == l_True){
+        // Extend & copy model:
+        model.growTo(nVars());
+        for (int i = 0; i < nVars(); i++) model[i] = value(i);
+    }else if (status == l_False && conflict.size() == 0)
+        ok = false;
+
+    cancelUntil(0);
+    return status;
+}
+
+
+bool Solver::implies(const vec<Lit>& assumps, vec<Lit>& out)
+{
+    trail_lim.push(trail.size());
+    for (int i = 0; i < assumps.size(); i++){
+        Lit a = assumps[i];
+
+        if (value(a) == l_False){
+            cancelUntil(0);
+            return false;
+        }else if (value(a) == l_Undef)
+            uncheckedEnqueue(a);
+    }
+
+    unsigned trail_before = trail.size();
+    bool     ret          = true;
+    if (propagate() == CRef_Undef){
+        out.clear();
+        for (int j = trail_before; j < trail.size(); j++)
+            out.push(trail[j]);
+    }else
+        ret = false;
+    
+    cancelUntil(0);
+    return ret;
+}
+
+//=================================================================================================
+// XOR constraints:
+
+
+// NOTE: XOR reasoning can not be expressed in a DRAT proof, so no constraints are added if a proof
+// is logged.
+void Solver::addXor(const vec<Lit>& ps)
+{
+    if (proof != NULL) return;
+    for (int i = 0; i < ps.size(); i++)
+        xor_lits.push(ps[i]);
+    xor_ends.push(xor_lits.size());
+}
+
+
+// Each row is written as the literals of its variables, the first one negated if the right hand
+// side is zero:
+void Solver::xorConstraints(vec<Lit>& out_lits, vec<int>& out_ends) const
+{
+    for (int i = 0; i < xor_lits.size(); i++)
+        out_lits.push(xor_lits[i]);
+    for (int i = 0; i < xor_ends.size(); i++)
+        out_ends.push(xor_ends[i] + out_lits.size() - xor_lits.size());
+
+    for (int i = 0; i < xor_matrices.size(); i++){
+        const XorMatrix& m = *xor_matrices[i];
+        for (int r = 0; r < m.nRows(); r++){
+            bool neg = !m.rhs(r);
+            for (int c = m.next(r, 0); c < m.nCols(); c = m.next(r, c + 1)){
+                out_lits.push(mkLit(m.vars[c], neg));
+                neg = false; }
+            out_ends.push(out_lits.size());
+        }
+    }
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  gaussBuild : [void]  ->  [bool]
+|  
+|  Description:
+|    (Re)build the XOR matrices from all XOR constraints, without the variables assigned at level 0.
+|    Constraints over a single variable become unit clauses. The others are split into connected
+|    components (constraints sharing variables), each of which becomes a matrix in reduced row
+|    echelon form, unless it has more than 'gauss_max_cols' variables. Does nothing if no constraint
+|    was added and no variable of a matrix is assigned. Returns FALSE if a conflict was found.
+|________________________________________________________________________________________________@*/
+bool Solver::gaussBuild()
+{
+    assert(decisionLevel() == 0);
+
+    bool changed = xor_ends.size() > 0;
+    for (int i = 0; i < xor_matrices.size() && !changed; i++)
+        for (int c = 0; c < xor_matrices[i]->nCols() && !changed; c++)
+            changed = value(xor_matrices[i]->vars[c]) != l_Undef;
+    if (!changed)
+        return true;
+
+    vec<Lit> lits;
+    vec<int> ends;
+    xorConstraints(lits, ends);
+    xor_lits.clear();
+    xor_ends.clear();
+    for (int i = 0; i < xor_matrices.size(); i++)
+        delete xor_matrices[i];
+    xor_matrices.clear();
+    xor_row_mat.clear();
+    for (int v = 0; v < xor_watches.size(); v++)
+        xor_watches[v]->clear();
+    growWatchLists(xor_watches, nVars());
+
+    // The rows are renumbered:
+    clearLazyReasons();
+
+    // Remove assigned and duplicate variables, and join the variables of each constraint in a
+    // union-find structure:
+    vec<Var>  vs, root(nVars());
+    vec<int>  vs_ends;
+    vec<char> rhs;
+    for (Var v = 0; v < nVars(); v++)
+        root[v] = v;
+    for (int i = 0, start = 0; i < ends.size(); start = ends[i++]){
+        bool b = true;
+        for (int k = start; k < ends[i]; k++){
+            Lit p = lits[k];
+            if (value(p) != l_Undef)
+                b ^= value(p) == l_True;
+            else{
+                b ^= sign(p);
+                seen[var(p)] ^= 1; }
+        }
+        int size = vs.size();
+        for (int k = start; k < ends[i]; k++)
+            if (seen[var(lits[k])]){
+                seen[var(lits[k])] = 0;
+                vs.push(var(lits[k])); }
+
+        if (vs.size() - size == 0){
+            if (b) return ok = false;
+        }else if (vs.size() - size == 1){
+            uncheckedEnqueue(mkLit(vs.last(), !b));
+            vs.pop();
+        }else{
+            for (int k = size + 1; k < vs.size(); k++){
+                Var x = vs[size], y = vs[k];
+                while (root[x] != x) x = root[x] = root[root[x]];
+                while (root[y] != y) y = root[y] = root[root[y]];
+                root[y] = x; }
+            vs_ends.push(vs.size());
+            rhs.push(b);
+        }
+    }
+
+    // Number the columns of each component, and create the matrices:
+    vec<int> col(nVars(), -1), mat(nVars(), -1);
+    vec<vec<Var> > cols;
+    for (int i = 0; i < vs.size(); i++){
+        Var r = vs[i];
+        while (root[r] != r) r = root[r];
+        if (mat[r] < 0){
+            mat[r] = cols.size();
+            cols.push(); }
+        if (col[vs[i]] < 0){
+            col[vs[i]] = cols[mat[r]].size();
+            cols[mat[r]].push(vs[i]); }
+    }
+    for (int i = 0; i < cols.size(); i++){
+        xor_matrices.push(new XorMatrix());
+        if (cols[i].size() <= gauss_max_cols)
+            xor_matrices.last()->init(cols[i]);
+    }
+    for (int i = 0, start = 0; i < vs_ends.size(); start = vs_ends[i++]){
+        Var r = vs[start];
+        while (root[r] != r) r = root[r];
+        XorMatrix& m = *xor_matrices[mat[r]];
+        if (m.nCols() == 0) continue;
+        int row = m.addRow();
+        for (int k = start; k < vs_ends[i]; k++)
+            m.flip(row, col[vs[k]]);
+        if (rhs[i])
+            m.flip(row, m.nCols());
+    }
+
+    // Eliminate, and set up the watches (rows with a single column are units):
+    int i, j;
+    for (i = j = 0; i < xor_matrices.size(); i++){
+        XorMatrix& m = *xor_matrices[i];
+        if (m.nCols() > 0 && !m.eliminate())
+            return ok = false;
+
+        for (int r = 0; r < m.nRows(); r++)
+            if (m.size(r) == 1){
+                Lit p = mkLit(m.vars[m.basic[r]], !m.rhs(r));
+                if (value(p) == l_False)
+                    return ok = false;
+                else if (value(p) == l_Undef)
+                    uncheckedEnqueue(p);
+                m.removeRow(r--);
+            }
+        if (m.nRows() == 0) continue;
+
+        XorMatrix* tmp = xor_matrices[j];
+        xor_matrices[j] = xor_matrices[i];
+        xor_matrices[i] = tmp;
+        XorMatrix& n = *xor_matrices[j++];
+        n.first = xor_row_mat.size();
+        for (int r = 0; r < n.nRows(); r++){
+            xor_row_mat.push(j - 1);
+            n.watch[r] = n.next(r, 0) != n.basic[r] ? n.next(r, 0) : n.next(r, n.basic[r] + 1);
+            xor_watches[n.vars[n.basic[r]]]->push(n.first + r);
+            xor_watches[n.vars[n.watch[r]]]->push(n.first + r);
+        }
+    }
+    for (int k = j; k < i; k++)
+        delete xor_matrices[k];
+    xor_matrices.shrink(i - j);
+
+    return propagate() == CRef_Undef || (ok = false);
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  gaussPropagate : (p : Lit)  ->  [CRef]
+|  
+|  Description:
+|    Propagate the XOR rows watching the variable of 'p', and return a conflicting clause or
+|    CRef_Undef. Each row watches its basic column and one other column. When the other watch is
+|    assigned, it moves to an unassigned column. If there is none, the basic variable is implied by
+|    the row (or checked against it). When the basic variable is assigned, an unassigned column is
+|    made basic instead, by adding the row to all other rows containing it (Gauss-Jordan elimination
+|    with watched columns). Implied variables get the reason 'CRef_Lazy', their clauses are built
+|    only if needed (see 'lazyReason()'). Conflicts are returned as clauses in 'lazy_clauses'.
+|  
+|    NOTE: if all non-basic columns of a row are assigned, it watches the one with the highest
+|    level, so that it is visited again as soon as any of them is unassigned (as for clauses after
+|    chronological backtracking).
+|________________________________________________________________________________________________@*/
+CRef Solver::gaussPropagate(Lit p)
+{
+    Var       x     = var(p);
+    vec<int>& ws    = *xor_watches[x];
+    CRef      confl = CRef_Undef;
+    int       i, j;
+
+    // NOTE: new watches of 'x' may be added while the loop runs (and are visited as well).
+    for (i = j = 0; i < ws.size(); i++){
+        int        r        = ws[i];
+        XorMatrix& m        = *xor_matrices[xor_row_mat[r]];
+        int        k        = r - m.first;
+        bool       is_basic = m.vars[m.basic[k]] == x;
+        if (!is_basic && m.vars[m.watch[k]] != x) continue;    // (stale)
+        if (confl != CRef_Undef){
+            ws[j++] = r;
+            continue; }
+
+        int  max_c;
+        bool parity;
+        int  c = gaussScan(m, k, m.watch[k], max_c, parity);
+        if (c >= 0 && !is_basic)
+            gaussWatch(m, k, c);
+        else if (c >= 0)
+            gaussPivot(m, k, c, confl);
+        else{
+            gaussWatch(m, k, max_c);
+            gaussImply(m, k, parity, confl);
+        }
+
+        // Keep the watch unless it was moved (or re-added by 'gaussWatch()'):
+        if (is_basic ? m.vars[m.basic[k]] == x : m.vars[m.watch[k]] == x)
+            ws[j++] = r;
+    }
+    ws.shrink(i - j);
+
+    return confl;
+}
+
+
+// Returns an unassigned non-basic column of row 'r', other than 'skip' if possible, or -1 if all
+// are assigned. In that case, 'max_c' is set to the one with the highest level, and 'parity' to
+// the value the basic variable must have.
+int Solver::gaussScan(const XorMatrix& m, int r, int skip, int& max_c, bool& parity) const
+{
+    bool found = false;
+    parity = m.rhs(r);
+    max_c  = -1;
+    for (int c = m.next(r, 0); c < m.nCols(); c = m.next(r, c + 1)){
+        if (c == m.basic[r]) continue;
+        Var v = m.vars[c];
+        if (value(v) == l_Undef){
+            if (c != skip) return c;
+            found = true;
+        }else{
+            parity ^= value(v) == l_True;
+            if (max_c < 0 || level(v) > level(m.vars[max_c]))
+                max_c = c; }
+    }
+    return found ? skip : -1;
+}
+
+
+void Solver::gaussWatch(XorMatrix& m, int r, int c)
+{
+    if (m.watch[r] != c){
+        m.watch[r] = c;
+        xor_watches[m.vars[c]]->push(m.first + r); }
+}
+
+
+// All non-basic columns of row 'r' are assigned: imply its basic variable, or return a conflict in
+// 'confl' if it is assigned the wrong value. Nothing is implied after a conflict:
+void Solver::gaussImply(XorMatrix& m, int r, bool parity, CRef& confl)
+{
+    Var b = m.vars[m.basic[r]];
+    if (value(b) == l_Undef){
+        if (confl != CRef_Undef) return;
+        uncheckedEnqueue(mkLit(b, !parity), level(m.vars[m.watch[r]]), CRef_Lazy);
+        lazy_from[b] = m.first + r;
+        m.implied[r] = b;
+        xor_props++;
+
+    }else if (value(b) != lbool(parity) && confl == CRef_Undef){
+        lazy_tmp.clear();
+        for (int c = m.next(r, 0); c < m.nCols(); c = m.next(r, c + 1))
+            lazy_tmp.push(mkLit(m.vars[c], value(m.vars[c]) == l_True));
+        confl = ca.alloc(lazy_tmp, false);
+        lazy_clauses.push(confl);
+        lazy_sweep = true;
+        xor_conflicts++;
+    }
+}
+
+
+// Row 'r' was changed: move its non-basic watch if it is no longer in the row or assigned.
+void Solver::gaussUpdate(XorMatrix& m, int r, CRef& confl)
+{
+    int w = m.watch[r];
+    if (m.get(r, w) && value(m.vars[w]) == l_Undef) return;
+
+    int  max_c;
+    bool parity;
+    int  c = gaussScan(m, r, -1, max_c, parity);
+    if (c >= 0)
+        gaussWatch(m, r, c);
+    else{
+        gaussWatch(m, r, max_c);
+        gaussImply(m, r, parity, confl);
+    }
+}
+
 
-                if (next == lit_Undef)
-                    // Model found:
-                    return l_True;
-            }
+// Make the unassigned column 'c' the basic column of row 'r', instead of its assigned one. The row
+// is added to every other row containing 'c'. These rows change, so the reasons they gave are built
+// first.
+void Solver::gaussPivot(XorMatrix& m, int r, int c, CRef& confl)
+{
+    xor_rows.clear();
+    for (int t = 0; t < m.nRows(); t++)
+        if (t != r && m.get(t, c)){
+            Var v = m.implied[t];
+            if (v != var_Undef && value(v) != l_Undef && vardata[v].reason == CRef_Lazy && lazy_from[v] == (uint32_t)(m.first + t))
+                lazyReason(v);
+            m.addTo(t, r);
+            xor_rows.push(t);
+        }
 
-            // Increase decision level and enqueue 'next'
-            newDecisionLevel();
-            uncheckedEnqueue(next);
+    m.pivot[m.basic[r]] = -1;
+    m.pivot[c] = r;
+    m.basic[r] = c;
+    xor_watches[m.vars[c]]->push(m.first + r);
+    if (m.watch[r] == c){
+        int  max_c;
+        bool parity;
+        int  d = gaussScan(m, r, -1, max_c, parity);
+        m.watch[r] = -1;
+        if (d >= 0)
+            gaussWatch(m, r, d);
+        else{
+            gaussWatch(m, r, max_c);
+            gaussImply(m, r, parity, confl);
         }
     }
+
+    for (int i = 0; i < xor_rows.size(); i++)
+        gaussUpdate(m, xor_rows[i], confl);
 }
 
 
-double Solver::progressEstimate() const
+// Build the reason clause of 'x', implied by the XOR row or cardinality constraint 'lazy_from[x]':
+// the implied literal and other literals of the constraint, all false. For an XOR row these are the
+// other literals of the row. The row has not changed since the implication (see 'gaussPivot()'),
+// and its other variables are still assigned, as they are on lower levels. For a cardinality
+// constraint they are the unwatched literals and the last watched one (see 'cardPropagate()').
+CRef Solver::lazyReason(Var x)
 {
-    double  progress = 0;
-    double  F = 1.0 / nVars();
-
-    for (int i = 0; i <= decisionLevel(); i++){
-        int beg = i == 0 ? 0 : trail_lim[i - 1];
-        int end = i == decisionLevel() ? trail.size() : trail_lim[i];
-        progress += pow(F, i) * (end - beg);
+    lazy_tmp.clear();
+    lazy_tmp.push(mkLit(x, value(x) == l_False));
+    if (lazy_from[x] & lazy_card){
+        const Card& c = cards[lazy_from[x] & ~lazy_card];
+        for (int k = c.bound; k < c.size; k++)
+            lazy_tmp.push(card_lits[c.first + k]);
+    }else{
+        int        r = lazy_from[x];
+        XorMatrix& m = *xor_matrices[xor_row_mat[r]];
+        r -= m.first;
+        for (int c = m.next(r, 0); c < m.nCols(); c = m.next(r, c + 1))
+            if (m.vars[c] != x)
+                lazy_tmp.push(mkLit(m.vars[c], value(m.vars[c]) == l_True));
     }
 
-    return progress / nVars();
+    CRef cr = ca.alloc(lazy_tmp, false);
+    lazy_clauses.push(cr);
+    vardata[x].reason = cr;
+    if (lazy_tmp.size() == 2)
+        vardata[x].bin = lazy_tmp[1];
+    return cr;
 }
 
-/*
-  Finite subsequences of the Luby-sequence:
 
-  0: 1
-  1: 1 1 2
-  2: 1 1 2 1 1 2 4
-  3: 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8
-  ...
+// Top-level assignments need no reasons. The lazy ones are dropped before the constraints that gave
+// them are changed at level 0:
+void Solver::clearLazyReasons()
+{
+    assert(decisionLevel() == 0);
+    for (int i = 0; i < trail.size(); i++)
+        if (vardata[var(trail[i])].reason == CRef_Lazy)
+            vardata[var(trail[i])].reason = CRef_Undef;
+}
 
 
- */
+// Free the clauses of lazy reasons that are no longer reasons (and old conflicts). Done at the start
+// of 'propagate()', when the last conflict has been analyzed.
+void Solver::lazySweep()
+{
+    int i, j;
+    for (i = j = 0; i < lazy_clauses.size(); i++)
+        if (locked(ca[lazy_clauses[i]]))
+            lazy_clauses[j++] = lazy_clauses[i];
+        else
+            ca.free(lazy_clauses[i]);
+    lazy_clauses.shrink(i - j);
+    lazy_sweep = false;
+}
 
-static double luby(double y, int x){
 
-    // Find the finite subsequence that contains index 'x', and the
-    // size of that subsequence:
-    int size, seq;
-    for (size = 1, seq = 0; size < x+1; seq++, size = 2*size+1);
+//=================================================================================================
+// Cardinality constraints:
 
-    while (size-1 != x){
-        size = (size-1)>>1;
-        seq--;
-        x = x % size;
+
+/*_________________________________________________________________________________________________
+|
+|  addAtLeast_ : (ps : vec<Lit>&) (k : int)  ->  [bool]
+|  
+|  Description:
+|    Add the constraint that at least 'k' of 'ps' are true. The literals must be over distinct
+|    variables, except for complementary pairs (exactly one of which is true). Assigned literals are
+|    removed first. If all remaining literals must be true, they are enqueued instead. Returns FALSE
+|    if the solver becomes contradictory.
+|  
+|    NOTE: the reasons given by cardinality constraints are not derived by resolution, so a proof is
+|    only valid if no constraints were added.
+|________________________________________________________________________________________________@*/
+bool Solver::addAtLeast_(vec<Lit>& ps, int k)
+{
+    assert(decisionLevel() == 0);
+    if (!ok) return false;
+
+    sort(ps);
+    int i, j;
+    for (i = j = 0; i < ps.size(); i++){
+        assert(i == 0 || ps[i] != ps[i-1]);
+        if (value(ps[i]) == l_True)
+            k--;
+        else if (value(ps[i]) == l_Undef){
+            if (j > 0 && ps[j-1] == ~ps[i]){
+                j--; k--;
+            }else
+                ps[j++] = ps[i]; }
     }
+    ps.shrink(i - j);
 
-    return pow(y, seq);
+    if (k <= 0)
+        return true;
+    else if (k > ps.size())
+        return ok = false;
+    else if (k == ps.size()){
+        for (int i = 0; i < ps.size(); i++)
+            uncheckedEnqueue(ps[i]);
+        return ok = (propagate() == CRef_Undef); }
+
+    Card c;
+    c.first = card_lits.size();
+    c.size  = ps.size();
+    c.bound = k;
+    for (int i = 0; i < ps.size(); i++)
+        card_lits.push(ps[i]);
+    cards.push(c);
+
+    growWatchLists(card_watches, 2 * nVars());
+    for (int i = 0; i <= k; i++)
+        card_watches[toInt(~ps[i])]->push(cards.size() - 1);
+
+    return true;
 }
 
-// NOTE: assumptions passed in member-variable 'assumptions'.
-lbool Solver::solve_()
+
+// Remove the top-level assignments from the cardinality constraints, by adding them again. Returns
+// FALSE if a conflict was found.
+bool Solver::cardSimplify()
 {
-    model.clear();
-    conflict.clear();
-    if (!ok) return l_False;
+    assert(decisionLevel() == 0);
 
-    solves++;
+    bool changed = false;
+    for (int i = 0; i < card_lits.size() && !changed; i++)
+        changed = value(card_lits[i]) != l_Undef;
+    if (!changed)
+        return true;
 
-    max_learnts = nClauses() * learntsize_factor;
-    if (max_learnts < min_learnts_lim)
-        max_learnts = min_learnts_lim;
+    vec<Card> cs;
+    vec<Lit>  lits, ps;
+    cards.moveTo(cs);
+    card_lits.moveTo(lits);
+    for (int i = 0; i < card_watches.size(); i++)
+        card_watches[i]->clear();
+    clearLazyReasons();
+
+    for (int i = 0; i < cs.size(); i++){
+        ps.clear();
+        for (int k = 0; k < cs[i].size; k++)
+            ps.push(lits[cs[i].first + k]);
+        if (!addAtLeast_(ps, cs[i].bound))
+            return false;
+    }
 
-    learntsize_adjust_confl   = learntsize_adjust_start_confl;
-    learntsize_adjust_cnt     = (int)learntsize_adjust_confl;
-    lbool   status            = l_Undef;
+    return true;
+}
 
-    if (verbosity >= 1){
-        printf("============================[ Search Statistics ]==============================\n");
-        printf("| Conflicts |          ORIGINAL         |          LEARNT          | Progress |\n");
-        printf("|           |    Vars  Clauses Literals |    Limit  Clauses Lit/Cl |          |\n");
-        printf("===============================================================================\n");
-    }
 
-    // Search:
-    int curr_restarts = 0;
-    while (status == l_Undef){
-        double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
-        status = search(rest_base * restart_first);
-        if (!withinBudget()) break;
-        curr_restarts++;
+/*_________________________________________________________________________________________________
+|
+|  cardPropagate : (p : Lit)  ->  [CRef]
+|  
+|  Description:
+|    Propagate the cardinality constraints watching '~p', which just became false, and return a
+|    conflicting clause or CRef_Undef. A constraint that at least 'k' of its literals are true
+|    watches the first 'k + 1' of them. A false watch is replaced by an unwatched literal that is not
+|    false. If there is none, the other 'k' watches are implied, or the constraint is conflicting if
+|    one of them is false as well. Implied literals get the reason 'CRef_Lazy', and conflicts are
+|    returned as clauses in 'lazy_clauses' (as for XOR constraints, see 'gaussPropagate()').
+|  
+|    NOTE: on an implication, the false watch is moved to position 'k'. The reason of the implied
+|    literals is then the literals from position 'k' on (see 'lazyReason()'). These stay false, and
+|    in place, as long as the implied literals are assigned.
+|________________________________________________________________________________________________@*/
+CRef Solver::cardPropagate(Lit p)
+{
+    Lit       false_lit = ~p;
+    vec<int>& ws        = *card_watches[toInt(p)];
+    CRef      confl     = CRef_Undef;
+    int       i, j;
+
+    for (i = j = 0; i < ws.size(); i++){
+        int ci = ws[i];
+        if (confl != CRef_Undef){
+            ws[j++] = ci;
+            continue; }
+
+        // Look for a new watch:
+        const Card& c    = cards[ci];
+        Lit*        lits = &card_lits[c.first];
+        int         w    = 0;
+        int         r    = c.bound + 1;
+        while (lits[w] != false_lit) w++;
+        while (r < c.size && value(lits[r]) == l_False) r++;
+        if (r < c.size){
+            lits[w] = lits[r]; lits[r] = false_lit;
+            card_watches[toInt(~lits[w])]->push(ci);
+            continue; }
+        ws[j++] = ci;
+
+        bool conflict = false;
+        for (int k = 0; k <= c.bound && !conflict; k++)
+            conflict = k != w && value(lits[k]) == l_False;
+
+        if (conflict){
+            lazy_tmp.clear();
+            for (int k = 0; k < c.size; k++)
+                if (value(lits[k]) == l_False)
+                    lazy_tmp.push(lits[k]);
+            confl = ca.alloc(lazy_tmp, false);
+            lazy_clauses.push(confl);
+            lazy_sweep = true;
+            card_conflicts++;
+        }else{
+            // Out-of-order as in 'propagate()': the implications are on the highest level of the reason.
+            lits[w] = lits[c.bound]; lits[c.bound] = false_lit;
+            int lev = level(var(false_lit));
+            for (int k = c.bound + 1; k < c.size; k++)
+                if (level(var(lits[k])) > lev)
+                    lev = level(var(lits[k]));
+            for (int k = 0; k < c.bound; k++)
+                if (value(lits[k]) == l_Undef){
+                    uncheckedEnqueue(lits[k], lev, CRef_Lazy);
+                    lazy_from[var(lits[k])] = lazy_card | ci;
+                    card_props++; }
+        }
     }
+    ws.shrink(i - j);
 
-    if (verbosity >= 1)
-        printf("===============================================================================\n");
+    return confl;
+}
 
 
-    if (status == l_True){
-        // Extend & copy model:
-        model.growTo(nVars());
-        for (int i = 0; i < nVars(); i++) model[i] = value(i);
-    }else if (status == l_False && conflict.size() == 0)
-        ok = false;
+//=================================================================================================
+// Linear constraints:
 
-    cancelUntil(0);
-    return status;
+
+struct linear_lt {
+    const vec<Lit>& ps;
+    linear_lt(const vec<Lit>& ps_) : ps(ps_) {}
+    bool operator () (int x, int y) { return ps[x] < ps[y]; }
+};
+
+/*_________________________________________________________________________________________________
+|
+|  addLinear_ : (ps : vec<Lit>&) (cs : vec<int64_t>&) (k : int64_t)  ->  [bool]
+|  
+|  Description:
+|    Add the constraint that the coefficients 'cs' of the true literals of 'ps' sum to at least 'k'.
+|    It is normalized first. Negative coefficients are made positive by negating their literals,
+|    literals over the same variable are merged, assigned literals are removed, and coefficients are
+|    clipped to the bound. A constraint with all coefficients equal is added as a cardinality
+|    constraint. Returns FALSE if the solver becomes contradictory.
+|  
+|    NOTE: the sum of the coefficients must fit in 64 bits. As for cardinality constraints, a proof
+|    is only valid if no linear constraints were added.
+|________________________________________________________________________________________________@*/
+bool Solver::addLinear_(vec<Lit>& ps, vec<int64_t>& cs, int64_t k)
+{
+    assert(decisionLevel() == 0);
+    assert(ps.size() == cs.size());
+    if (!ok) return false;
+
+    // Make the coefficients positive ('c*p = c + (-c)*~p'), and sort the terms by variable:
+    vec<int> order;
+    for (int i = 0; i < ps.size(); i++){
+        if (cs[i] < 0){
+            k    -= cs[i];
+            ps[i] = ~ps[i];
+            cs[i] = -cs[i]; }
+        order.push(i); }
+    sort(order, linear_lt(ps));
+
+    vec<Lit>     lits;
+    vec<int64_t> coefs;
+    for (int i = 0; i < order.size(); i++){
+        Lit     p = ps[order[i]];
+        int64_t c = cs[order[i]];
+        if (value(p) == l_True)
+            k -= c;
+        else if (value(p) == l_False || c == 0)
+            continue;
+        else if (lits.size() > 0 && lits.last() == p)
+            coefs.last() += c;
+        else if (lits.size() > 0 && lits.last() == ~p){
+            // 'a*q + c*~q' is 'c + (a - c)*q', or 'a + (c - a)*~q':
+            int64_t a = coefs.last();
+            k -= a < c ? a : c;
+            if (a == c){
+                lits.pop();
+                coefs.pop();
+            }else if (a < c){
+                lits.last()  = p;
+                coefs.last() = c - a;
+            }else
+                coefs.last() = a - c;
+        }else{
+            lits.push(p);
+            coefs.push(c); }
+    }
+
+    if (k <= 0)
+        return true;
+
+    int64_t sum = 0, max_coef = 0;
+    bool    card = true;
+    for (int i = 0; i < coefs.size(); i++){
+        if (coefs[i] > k) coefs[i] = k;
+        sum     += coefs[i];
+        max_coef = coefs[i] > max_coef ? coefs[i] : max_coef;
+        card    &= coefs[i] == coefs[0]; }
+    if (sum < k)
+        return ok = false;
+    else if (card)
+        return addAtLeast_(lits, (int)((k + coefs[0] - 1) / coefs[0]));
+
+    Linear c;
+    c.first    = lin_lits.size();
+    c.size     = lits.size();
+    c.watched  = 0;
+    c.bound    = k;
+    c.max_coef = max_coef;
+    for (int i = 0; i < lits.size(); i++){
+        lin_lits.push(lits[i]);
+        lin_coefs.push(coefs[i]); }
+    linears.push(c);
+    growWatchLists(lin_watches, 2 * nVars());
+
+    int     ci    = linears.size() - 1;
+    CRef    confl = CRef_Undef;
+    int64_t w_sum = linearWatch(ci);
+    if (w_sum < c.bound + c.max_coef)
+        linearImply(ci, w_sum, confl);
+
+    return ok = (confl == CRef_Undef && propagate() == CRef_Undef);
 }
 
 
-bool Solver::implies(const vec<Lit>& assumps, vec<Lit>& out)
+// Remove the top-level assignments from the linear constraints, by adding them again. Returns FALSE
+// if a conflict was found.
+bool Solver::linearSimplify()
 {
-    trail_lim.push(trail.size());
-    for (int i = 0; i < assumps.size(); i++){
-        Lit a = assumps[i];
+    assert(decisionLevel() == 0);
 
-        if (value(a) == l_False){
-            cancelUntil(0);
+    bool changed = false;
+    for (int i = 0; i < lin_lits.size() && !changed; i++)
+        changed = value(lin_lits[i]) != l_Undef;
+    if (!changed)
+        return true;
+
+    vec<Linear>  ls;
+    vec<Lit>     lits, ps;
+    vec<int64_t> coefs, cs;
+    linears.moveTo(ls);
+    lin_lits.moveTo(lits);
+    lin_coefs.moveTo(coefs);
+    for (int i = 0; i < lin_watches.size(); i++)
+        lin_watches[i]->clear();
+
+    for (int i = 0; i < ls.size(); i++){
+        ps.clear();
+        cs.clear();
+        for (int k = 0; k < ls[i].size; k++){
+            ps.push(lits [ls[i].first + k]);
+            cs.push(coefs[ls[i].first + k]); }
+        if (!addLinear_(ps, cs, ls[i].bound))
             return false;
-        }else if (value(a) == l_Undef)
-            uncheckedEnqueue(a);
     }
 
-    unsigned trail_before = trail.size();
-    bool     ret          = true;
-    if (propagate() == CRef_Undef){
-        out.clear();
-        for (int j = trail_before; j < trail.size(); j++)
-            out.push(trail[j]);
-    }else
-        ret = false;
-    
-    cancelUntil(0);
-    return ret;
+    return true;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  linearPropagate : (p : Lit)  ->  [CRef]
+|  
+|  Description:
+|    Propagate the linear constraints watching '~p', which just became false, and return a
+|    conflicting clause or CRef_Undef. Each constraint watches enough literals that the coefficients
+|    of the ones not false exceed its bound by at least its largest coefficient (the watched slack),
+|    so that no literal can be implied. When a watched literal becomes false, more literals are
+|    watched to restore this, and the false one is dropped. If there are not enough, all literals
+|    that are not false are watched, so the watched slack is the real slack: the literals with a
+|    larger coefficient are implied, and a negative slack is a conflict.
+|  
+|    NOTE: the reasons are clauses (see 'linearReason()'), built on implication, as the literals
+|    that were false at the time can not be told apart later. They are kept in 'lazy_clauses'.
+|________________________________________________________________________________________________@*/
+CRef Solver::linearPropagate(Lit p)
+{
+    Lit       false_lit = ~p;
+    vec<int>& ws        = *lin_watches[toInt(p)];
+    CRef      confl     = CRef_Undef;
+    int       i, j;
+
+    for (i = j = 0; i < ws.size(); i++){
+        int ci = ws[i];
+        if (confl != CRef_Undef){
+            ws[j++] = ci;
+            continue; }
+
+        int64_t sum = linearWatch(ci);
+        Linear& c   = linears[ci];
+        if (sum >= c.bound + c.max_coef){
+            // Stop watching 'false_lit':
+            Lit*     lits  = &lin_lits [c.first];
+            int64_t* coefs = &lin_coefs[c.first];
+            int      w     = 0;
+            while (lits[w] != false_lit) w++;
+            c.watched--;
+            lits [w] = lits [c.watched]; lits [c.watched] = false_lit;
+            int64_t tmp = coefs[w]; coefs[w] = coefs[c.watched]; coefs[c.watched] = tmp;
+            continue; }
+
+        ws[j++] = ci;
+        linearImply(ci, sum, confl);
+    }
+    ws.shrink(i - j);
+
+    return confl;
+}
+
+
+// Watch more literals of constraint 'ci' that are not false, until the watched slack is at least
+// the largest coefficient (or all are watched). Returns the sum of the coefficients of the watched
+// literals that are not false.
+int64_t Solver::linearWatch(int ci)
+{
+    Linear&  c     = linears[ci];
+    Lit*     lits  = &lin_lits [c.first];
+    int64_t* coefs = &lin_coefs[c.first];
+    int64_t  sum   = 0;
+    for (int k = 0; k < c.watched; k++)
+        if (value(lits[k]) != l_False)
+            sum += coefs[k];
+
+    for (int k = c.watched; k < c.size && sum < c.bound + c.max_coef; k++)
+        if (value(lits[k]) != l_False){
+            Lit     q = lits[k];
+            int64_t a = coefs[k];
+            lits [k] = lits [c.watched]; lits [c.watched] = q;
+            coefs[k] = coefs[c.watched]; coefs[c.watched] = a;
+            lin_watches[toInt(~q)]->push(ci);
+            c.watched++;
+            sum += a; }
+
+    return sum;
+}
+
+
+// All literals of constraint 'ci' that are not false are watched, and their coefficients sum to
+// 'sum': imply those with a coefficient above the slack, or return a conflict in 'confl'.
+void Solver::linearImply(int ci, int64_t sum, CRef& confl)
+{
+    const Linear& c     = linears[ci];
+    int64_t       slack = sum - c.bound;
+
+    if (slack < 0){
+        confl = linearReason(c, lit_Undef, -slack);
+        linear_conflicts++;
+        return; }
+
+    for (int k = 0; k < c.watched; k++){
+        Lit     q = lin_lits [c.first + k];
+        int64_t a = lin_coefs[c.first + k];
+        if (a > slack && value(q) == l_Undef){
+            // Out-of-order as in 'propagate()': the implication is on the highest level of the reason.
+            CRef          cr  = linearReason(c, q, a - slack);
+            const Clause& r   = ca[cr];
+            int           lev = 0;
+            for (int j = 1; j < r.size(); j++)
+                lev = level(var(r[j])) > lev ? level(var(r[j])) : lev;
+            uncheckedEnqueue(q, lev, cr, r.size() == 2 ? r[1] : lit_Undef);
+            linear_props++;
+        }
+    }
+}
+
+
+// The clause of 'p' and the false literals of 'c', or of the false literals only if 'p' is
+// 'lit_Undef' (a conflict). False literals with coefficients summing to less than 'room' are left
+// out: the rest are still enough to imply 'p' (or the conflict).
+CRef Solver::linearReason(const Linear& c, Lit p, int64_t room)
+{
+    lazy_tmp.clear();
+    if (p != lit_Undef)
+        lazy_tmp.push(p);
+    for (int k = 0; k < c.size; k++){
+        Lit     q = lin_lits [c.first + k];
+        int64_t a = lin_coefs[c.first + k];
+        if (value(q) != l_False)
+            continue;
+        else if (a < room)
+            room -= a;
+        else
+            lazy_tmp.push(q);
+    }
+
+    CRef cr = ca.alloc(lazy_tmp, false);
+    lazy_clauses.push(cr);
+    lazy_sweep = true;
+    return cr;
 }
 
+
 //=================================================================================================
 // Writing CNF to DIMACS:
 // 
@@ -993,15 +2929,161 @@ void Solver::printStats() const
     double cpu_time = cpuTime();
     double mem_used = memUsedPeak();
     printf("restarts              : %"PRIu64"\n", starts);
+    if (restart_mode != 0)
+        printf("blocked restarts      : %-12" PRIu64 "   (%" PRIu64 " phase switches)\n", blocked_restarts, mode_switches);
+    if (rephase_first > 0)
+        printf("rephases              : %-12" PRIu64 "   (%" PRIu64 " walks, %" PRIu64 " flips)\n", rephases, walks, walk_flipped);
+    if (inprocess_first > 0)
+        printf("inprocessings         : %-12" PRIu64 "   (%" PRIu64 " vivified clauses, %" PRIu64 " literals removed)\n", inprocessings, vivified_clauses, vivified_lits);
+    if (inprocess_first > 0 && use_probe)
+        printf("probes                : %-12" PRIu64 "   (%" PRIu64 " failed, %" PRIu64 " lifted, %" PRIu64 " hyper-binary)\n", probes, failed_lits, lifted_lits, hbr_clauses);
     printf("conflicts             : %-12"PRIu64"   (%.0f /sec)\n", conflicts   , conflicts   /cpu_time);
     printf("decisions             : %-12"PRIu64"   (%4.2f %% random) (%.0f /sec)\n", decisions, (float)rnd_decisions*100 / (float)decisions, decisions   /cpu_time);
     printf("propagations          : %-12"PRIu64"   (%.0f /sec)\n", propagations, propagations/cpu_time);
     printf("conflict literals     : %-12"PRIu64"   (%4.2f %% deleted)\n", tot_literals, (max_literals - tot_literals)*100 / (double)max_literals);
+    if (chronoBT())
+        printf("chrono backtracks     : %-12" PRIu64 "   (%4.2f %% of conflicts)\n", chrono_backtracks, chrono_backtracks*100 / (double)conflicts);
+    if (xor_matrices.size() > 0)
+        printf("xor propagations      : %-12" PRIu64 "   (%" PRIu64 " conflicts, %d rows)\n", xor_props, xor_conflicts, xor_row_mat.size());
+    if (cards.size() > 0)
+        printf("card propagations     : %-12" PRIu64 "   (%" PRIu64 " conflicts, %d constraints)\n", card_props, card_conflicts, cards.size());
+    if (linears.size() > 0)
+        printf("linear propagations   : %-12" PRIu64 "   (%" PRIu64 " conflicts, %d constraints)\n", linear_props, linear_conflicts, linears.size());
     if (mem_used != 0) printf("Memory used           : %.2f MB\n", mem_used);
     printf("CPU time              : %g s\n", cpu_time);
 }
 
 
+//=================================================================================================
+// Proof logging:
+
+
+bool Solver::openProof(const char* file, bool binary, bool lrat)
+{
+    closeProof();
+    proof = new Proof();
+    if (!proof->open(file, binary, lrat)){
+        delete proof;
+        proof = NULL;
+        return false; }
+
+    ca.clause_ids = lrat;
+    proof_units   = trail.size();
+    return true;
+}
+
+
+void Solver::closeProof()
+{
+    if (proof == NULL) return;
+    proof->close();
+    delete proof;
+    proof         = NULL;
+    ca.clause_ids = false;
+}
+
+
+// Top-level implications are logged as unit clauses lazily, the first time they are needed in a
+// hint or before their reasons are deleted (which DRAT checkers would otherwise have to ignore).
+// Their reasons only contain literals that precede them on the trail, so each unit only depends on
+// units logged before it. The hints (and the numbers of the units) are only needed for LRAT.
+void Solver::proofUnits()
+{
+    if (proof == NULL) return;
+
+    int end = trail_lim.size() > 0 ? trail_lim[0] : trail.size();
+    for (; proof_units < end; proof_units++){
+        Lit  p  = trail[proof_units];
+        CRef cr = reason(var(p));
+        if (cr == CRef_Undef) continue;    // (the number was set when 'p' was enqueued)
+
+        proof_tmp.clear();
+        if (lrat()){
+            const Clause& c = ca[cr];
+            for (int i = 0; i < c.size(); i++)
+                if (var(c[i]) != var(p))
+                    proof_tmp.push(unit_id[var(c[i])]);
+            proof_tmp.push(c.id());
+            unit_id[var(p)] = proof->newId(); }
+        proof->add(unit_id[var(p)], &p, 1, proof_tmp);
+    }
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  proofChain : (confl : CRef) (c : const vec<Lit>&) (out_hints : vec<uint64_t>&)  ->  [void]
+|  
+|  Description:
+|    Compute the LRAT hints showing that the clause 'c' follows by unit propagation, given that the
+|    current assignment, in which all literals of 'c' are false, led to the conflict 'confl'. The
+|    implication graph is searched backwards from 'confl', stopping at literals of 'c', top-level
+|    assignments and decisions. The reasons are emitted in post-order, so that each one becomes unit
+|    when the checker reaches it, preceded by the units of all top-level literals involved.
+|________________________________________________________________________________________________@*/
+void Solver::proofChain(CRef confl, const vec<Lit>& c, vec<uint64_t>& out_hints)
+{
+    out_hints.clear();
+    if (!lrat()) return;
+    proofUnits();
+
+    vec<ShrinkStackElem>& stack = analyze_stack;
+    stack.clear();
+    proof_tmp.clear();
+    analyze_toclear.clear();
+    for (int i = 0; i < c.size(); i++){
+        seen[var(c[i])] = 1;
+        analyze_toclear.push(c[i]); }
+
+    // The element being expanded is the implied literal 'p' (or 'lit_Undef' for the conflict):
+    CRef     cr = confl;
+    Lit      p  = lit_Undef;
+    uint32_t i  = 0;
+    for (;;){
+        const Clause& r = ca[cr];
+        if (i < (uint32_t)r.size()){
+            Lit q = r[i++];
+            Var x = var(q);
+            if (seen[x] || (p != lit_Undef && x == var(p))) continue;
+
+            seen[x] = 1;
+            analyze_toclear.push(q);
+            if (level(x) == 0)
+                out_hints.push(unit_id[x]);
+            else if (reason(x) != CRef_Undef){
+                stack.push(ShrinkStackElem(i, p));
+                p  = ~q;
+                cr = reason(x);
+                i  = 0;
+            }
+        }else{
+            proof_tmp.push(r.id());
+            if (stack.size() == 0) break;
+
+            i  = stack.last().i;
+            p  = stack.last().l;
+            cr = p == lit_Undef ? confl : reason(var(p));
+            stack.pop();
+        }
+    }
+
+    for (int i = 0; i < proof_tmp.size(); i++)
+        out_hints.push(proof_tmp[i]);
+    for (int i = 0; i < analyze_toclear.size(); i++)
+        seen[var(analyze_toclear[i])] = 0;
+}
+
+
+void Solver::proofEmpty(CRef confl)
+{
+    if (proof == NULL) return;
+
+    vec<Lit> empty;
+    proofChain(confl, empty, proof_hints);
+    proofAdd(empty, proof_hints);
+}
+
+
 //=================================================================================================
 // Garbage Collection methods:
 
@@ -1010,12 +3092,16 @@ void Solver::relocAll(ClauseAllocator& to)
     // All watchers:
     //
     watches.cleanAll();
+    watches_bin.cleanAll();
     for (int v = 0; v < nVars(); v++)
         for (int s = 0; s < 2; s++){
             Lit p = mkLit(v, s);
             vec<Watcher>& ws = watches[p];
             for (int j = 0; j < ws.size(); j++)
                 ca.reloc(ws[j].cref, to);
+            vec<Watcher>& wbin = watches_bin[p];
+            for (int j = 0; j < wbin.size(); j++)
+                ca.reloc(wbin[j].cref, to);
         }
 
     // All reasons:
@@ -1025,15 +3111,25 @@ void Solver::relocAll(ClauseAllocator& to)
 
         // Note: it is not safe to call 'locked()' on a relocated clause. This is why we keep
         // 'dangling' reasons here. It is safe and does not hurt.
-        if (reason(v) != CRef_Undef && (ca[reason(v)].reloced() || locked(ca[reason(v)]))){
-            assert(!isRemoved(reason(v)));
+        CRef cr = vardata[v].reason;
+        if (cr != CRef_Undef && cr != CRef_Lazy && (ca[cr].reloced() || locked(ca[cr]))){
+            assert(!isRemoved(cr));
             ca.reloc(vardata[v].reason, to);
         }
     }
 
-    // All learnt:
+    // Clauses of lazy reasons (the ones that are no longer reasons are dropped):
     //
     int i, j;
+    for (i = j = 0; i < lazy_clauses.size(); i++)
+        if (ca[lazy_clauses[i]].reloced()){
+            ca.reloc(lazy_clauses[i], to);
+            lazy_clauses[j++] = lazy_clauses[i];
+        }
+    lazy_clauses.shrink(i - j);
+
+    // All learnt:
+    //
     for (i = j = 0; i < learnts.size(); i++)
         if (!isRemoved(learnts[i])){
             ca.reloc(learnts[i], to);
@@ -1058,6 +3154,7 @@ void Solver::garbageCollect()
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted()); 
 
+    to.clause_ids = ca.clause_ids;
     relocAll(to);
     if (verbosity >= 2)
         printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n", 
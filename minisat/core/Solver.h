@@ -27,6 +27,9 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "minisat/mtl/IntMap.h"
 #include "minisat/utils/Options.h"
 #include "minisat/core/SolverTypes.h"
+#include "minisat/core/Proof.h"
+#include "minisat/core/Vmtf.h"
+#include "minisat/core/Gauss.h"
 
 
 namespace Minisat {
@@ -46,6 +49,7 @@ public:
     //
     Var     newVar    (lbool upol = l_Undef, bool dvar = true); // Add a new variable with parameters specifying variable mode.
     void    releaseVar(Lit l);                                  // Make literal true and promise to never refer to variable again.
+    void    reserve   (int n_vars, int n_clauses, uint64_t n_lits);  // Pre-allocate room for a problem of the given size (a hint only).
 
     bool    addClause (const vec<Lit>& ps);                     // Add a clause to the solver. 
     bool    addEmptyClause();                                   // Add the empty clause, making the solver contradictory.
@@ -55,6 +59,11 @@ public:
     bool    addClause (Lit p, Lit q, Lit r, Lit s);             // Add a quaternary clause to the solver. 
     bool    addClause_(      vec<Lit>& ps);                     // Add a clause to the solver without making superflous internal copy. Will
                                                                 // change the passed vector 'ps'.
+    bool    addAtMost (const vec<Lit>& ps, int k);              // Add the constraint that at most 'k' of 'ps' are true.
+    bool    addAtLeast(const vec<Lit>& ps, int k);              // Add the constraint that at least 'k' of 'ps' are true.
+    bool    addAtLeast_(     vec<Lit>& ps, int k);              // Add an at-least constraint without making an internal copy (changes 'ps').
+    bool    addLinear (const vec<Lit>& ps, const vec<int64_t>& cs, int64_t k); // Add the constraint that the sum of 'cs[i]' for the true 'ps[i]' is at least 'k'.
+    bool    addLinear_(      vec<Lit>& ps,       vec<int64_t>& cs, int64_t k); // Add a linear constraint without making an internal copy (changes 'ps' and 'cs').
 
     // Solving:
     //
@@ -117,6 +126,12 @@ public:
     void    checkGarbage(double gf);
     void    checkGarbage();
 
+    // Proof logging:
+    //
+    bool    openProof (const char* file, bool binary = true, bool lrat = false); // Log a DRAT (or LRAT) proof of unsatisfiability. Must
+                                                                                 // be called before any clause is added.
+    void    closeProof();                                                        // Write the rest of the proof and close its file.
+
     // Extra results: (read-only member variable)
     //
     vec<lbool> model;             // If problem is satisfiable, this vector contains the model (if any).
@@ -137,9 +152,27 @@ public:
     bool      rnd_init_act;       // Initialize variable activities with a small random value.
     double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
     int       min_learnts_lim;    // Minimum number to set the learnts limit to.
+    int       core_lbd;           // Learnt clauses with at most this LBD are kept forever.
+    int       tier2_lbd;          // Learnt clauses with at most this LBD are kept as long as they are used.
+    int       chrono;             // Backtrack only one level if the backjump would skip more levels than this (-1=never).
+    bool      reuse_trail;        // Keep the decision levels on restarts that would be decided again anyway.
 
     int       restart_first;      // The initial restart limit.                                                                (default 100)
     double    restart_inc;        // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
+    int       restart_mode;       // 0=Luby/geometric, 1=dynamic (LBD averages), 2=alternate stable (Luby) and focused (dynamic) phases.
+    double    restart_margin;     // Dynamic restart if the fast LBD average exceeds the slow one by this factor.            (default 1.1)
+    double    restart_block;      // Block dynamic restarts while the trail is longer than its average times this factor.   (default 1.4)
+    int       mode_first;         // The number of conflicts of the first focused phase (phase 'n' takes 'n^2' times more). (default 1000)
+    int       branching;          // Decision heuristic (see 'branch_vsids' etc).
+    int       branch_stable;      // Decision heuristic of stable phases in restart mode 2 (-1=same as 'branching').
+    double    lrb_step_min;       // The final LRB step size (it starts at 0.4 and decreases by 10^-6 per conflict).
+    int       target_mode;        // Decide on the target phase (0=never, 1=in stable phases, 2=always).
+    int       rephase_first;      // Conflicts before the first rephasing (0=never). The n:th interval is 'n' times longer.
+    int       walk_flips;         // Flips of the first local search when rephasing (0=never). The n:th is 'n' times longer.
+    int       inprocess_first;    // Conflicts before the first inprocessing round (0=never). The n:th interval is 'n' times longer.
+    double    inprocess_effort;   // Ticks of each inprocessing technique, relative to the propagations since the last round.
+    bool      use_vivify;         // Vivify learnt clauses when inprocessing.
+    bool      use_probe;          // Probe the roots of the binary implication graph when inprocessing.
     double    learntsize_factor;  // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
     double    learntsize_inc;     // The limit for learnt clauses is multiplied with this factor each restart.                 (default 1.1)
 
@@ -148,15 +181,18 @@ public:
 
     // Statistics: (read-only member variable)
     //
-    uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts;
+    uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts, chrono_backtracks;
+    uint64_t blocked_restarts, mode_switches, rephases, walks, walk_flipped, inprocessings;
+    uint64_t vivified_clauses, vivified_lits, probes, failed_lits, lifted_lits, hbr_clauses, xor_props, xor_conflicts;
+    uint64_t card_props, card_conflicts, linear_props, linear_conflicts;
     uint64_t dec_vars, num_clauses, num_learnts, clauses_literals, learnts_literals, max_literals, tot_literals;
 
 protected:
 
     // Helper structures:
     //
-    struct VarData { CRef reason; int level; };
-    static inline VarData mkVarData(CRef cr, int l){ VarData d = {cr, l}; return d; }
+    struct VarData { CRef reason; int level; Lit bin; }; // 'bin' is the false literal of a binary 'reason' (or 'lit_Undef').
+    static inline VarData mkVarData(CRef cr, int l, Lit b = lit_Undef){ VarData d = {cr, l, b}; return d; }
 
     struct Watcher {
         CRef cref;
@@ -179,6 +215,58 @@ protected:
         VarOrderLt(const IntMap<Var, double>&  act) : activity(act) { }
     };
 
+    struct VmtfLt {
+        const Vmtf& vmtf;
+        bool operator () (Var x, Var y) const { return vmtf[x] < vmtf[y]; }
+        VmtfLt(const Vmtf& q) : vmtf(q) { }
+    };
+
+    // Learnt clause database tiers (stored in each learnt clause):
+    enum { tier_core = 0, tier_mid = 1, tier_local = 2 };
+
+    // The most variables and clauses 'reserve()' makes room for (the counts may come from an
+    // unchecked DIMACS header):
+    enum { reserve_vars_max = 1 << 18, reserve_clauses_max = 1 << 21 };
+
+    // A cardinality constraint: at least 'bound' of the 'size' literals starting at 'card_lits[first]'
+    // are true. The first 'bound + 1' of them are watched (see 'cardPropagate()'):
+    struct Card { int first, size, bound; };
+
+    // A linear pseudo-Boolean constraint: the sum of the coefficients of the true literals is at least
+    // 'bound'. The literals start at 'lin_lits[first]', their coefficients at 'lin_coefs[first]'. The
+    // first 'watched' of them are watched (see 'linearPropagate()'):
+    struct Linear { int first, size, watched; int64_t bound, max_coef; };
+
+    // Marks the lazy reasons given by cardinality constraints in 'lazy_from':
+    enum { lazy_card = 0x80000000 };
+
+    // Decision heuristics:
+    enum { branch_vsids = 0, branch_vmtf = 1, branch_lrb = 2 };
+
+    // XOR constraints with more variables in their connected component are left to the clauses:
+    enum { gauss_max_cols = 2048 };
+
+    // Learning rate based branching: per variable statistics of the current assignment.
+    struct LrbData {
+        uint64_t assigned;      // Number of conflicts when the variable was assigned..
+        uint64_t canceled;      // .. unassigned, or last decayed while unassigned.
+        uint32_t participated;  // Number of conflicts the variable took part in since it was assigned.
+        uint32_t reasoned;      // Number of conflicts the variable was in the reason of a learnt literal.
+    };
+
+    // Exponential moving average, corrected for the bias towards its initial value of zero:
+    struct EMA {
+        double value, biased, beta, alpha;
+        EMA(double a) : value(0), biased(0), beta(1), alpha(a) {}
+        void update(double y){
+            biased += alpha * (y - biased);
+            if (beta > 1e-20){
+                beta  *= 1 - alpha;
+                value  = biased / (1 - beta);
+            }else
+                value  = biased; }
+    };
+
     struct ShrinkStackElem {
         uint32_t i;
         Lit      l;
@@ -188,7 +276,7 @@ protected:
     // Solver state:
     //
     vec<CRef>           clauses;          // List of problem clauses.
-    vec<CRef>           learnts;          // List of learnt clauses.
+    vec<CRef>           learnts;          // List of learnt clauses (all tiers).
     vec<Lit>            trail;            // Assignment stack; stores all assigments made in the order they were made.
     vec<int>            trail_lim;        // Separator indices for different decision levels in 'trail'.
     vec<Lit>            assumptions;      // Current set of assumptions provided to solve by the user.
@@ -196,13 +284,21 @@ protected:
     VMap<double>        activity;         // A heuristic measurement of the activity of a variable.
     VMap<lbool>         assigns;          // The current assignments.
     VMap<char>          polarity;         // The preferred polarity of each variable.
+    VMap<char>          target_phase;     // The polarities of the longest conflict free assignment since the last rephasing..
+    VMap<char>          best_phase;       // .. and since the last rephasing to it.
     VMap<lbool>         user_pol;         // The users preferred polarity of each variable.
     VMap<char>          decision;         // Declares if a variable is eligible for selection in the decision heuristic.
     VMap<VarData>       vardata;          // Stores reason and level for each variable.
     OccLists<Lit, vec<Watcher>, WatcherDeleted, MkIndexLit>
                         watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    OccLists<Lit, vec<Watcher>, WatcherDeleted, MkIndexLit>
+                        watches_bin;      // 'watches_bin[lit]' is a list of binary clauses watching 'lit'. The blocker is the implied literal.
 
     Heap<Var,VarOrderLt>order_heap;       // A priority queue of variables ordered with respect to the variable activity.
+    Vmtf                vmtf;             // The variables in the order they were last bumped (used instead of 'order_heap' by VMTF).
+    VMap<LrbData>       lrb;              // Statistics of the current assignment used by LRB to compute the new activity.
+    double              lrb_step;         // The current LRB step size.
+    int                 heuristic;        // The decision heuristic in use (only its structure, 'order_heap' or 'vmtf', is kept up-to-date).
 
     bool                ok;               // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
     double              cla_inc;          // Amount to bump next clause with.
@@ -225,8 +321,75 @@ protected:
     vec<ShrinkStackElem>analyze_stack;
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
+    vec<int64_t>        coef_tmp;         // Coefficients of the literals in 'add_tmp' for 'addLinear()'.
+    vec<Lit>            cancel_tmp;       // Assignments kept by 'cancelUntil()' from above the target level.
+    vec<Var>            vmtf_bumped;      // Variables to move to the front of 'vmtf' after the current conflict.
+    vec<uint64_t>       lbd_seen;         // Per decision level stamp used by 'computeLBD()'.
+    uint64_t            lbd_stamp;
+    vec<uint64_t>       proof_hints;      // LRAT hints of the next derived clause.
+    vec<uint64_t>       proof_tmp;
+
+    // Proof state:
+    //
+    Proof*              proof;            // The proof being logged, or NULL.
+    VMap<uint64_t>      unit_id;          // LRAT: number of the unit clause of each top-level assignment.
+    int                 proof_units;      // LRAT: number of top-level assignments on the trail with a valid 'unit_id'.
+    uint64_t            add_id;           // If non-zero, the clause passed to 'addClause_()' is not an input clause but was
+                                          // already logged as derived, with this number.
 
-    double              max_learnts;
+    // Restart state:
+    //
+    EMA                 lbd_fast;         // Moving average of the LBD of learnt clauses over about 32 conflicts.
+    EMA                 lbd_slow;         // Moving average of the LBD of learnt clauses over about 10^5 conflicts.
+    EMA                 trail_avg;        // Moving average of the trail size at conflicts.
+    bool                focused;          // Use dynamic restarts (otherwise the search is in a stable phase).
+    uint64_t            mode_limit;       // Number of conflicts at which the current phase ends (restart mode 2).
+    VMap<double>        mode_activity;    // Variable activities of the other phase.
+    double              mode_var_inc;     // Activity increment of the other phase.
+
+    // Phase state:
+    //
+    int                 target_assigned;  // Size of the assignment stored in 'target_phase'.
+    int                 best_assigned;    // Size of the assignment stored in 'best_phase'.
+    uint64_t            rephase_limit;    // Number of conflicts at which to rephase next.
+
+    // Inprocessing state:
+    //
+    uint64_t            inprocess_limit;  // Number of conflicts at which to inprocess next.
+    uint64_t            inprocess_props;  // Number of propagations at the end of the last round.
+    Var                 probe_next;       // Variable at which the next probing round starts.
+
+    // XOR constraint state (see 'gaussPropagate()'):
+    //
+    vec<XorMatrix*>     xor_matrices;     // One matrix per connected component of the XOR constraints.
+    vec<int>            xor_row_mat;      // The matrix of each row, by row number (see 'XorMatrix::first').
+    vec<vec<int>*>      xor_watches;      // '*xor_watches[v]' is a list of rows watching 'v' (some may be stale).
+    vec<Lit>            xor_lits;         // The XOR constraints added since the last 'gaussBuild()'..
+    vec<int>            xor_ends;         // .. and where each of them ends in 'xor_lits'.
+    vec<int>            xor_rows;         // Temporary: the rows changed by 'gaussPivot()'.
+
+    // Cardinality constraint state (see 'cardPropagate()'):
+    //
+    vec<Card>           cards;
+    vec<Lit>            card_lits;
+    vec<vec<int>*>      card_watches;     // '*card_watches[toInt(p)]' is a list of constraints watching '~p'.
+
+    // Linear constraint state (see 'linearPropagate()'):
+    //
+    vec<Linear>         linears;
+    vec<Lit>            lin_lits;
+    vec<int64_t>        lin_coefs;
+    vec<vec<int>*>      lin_watches;      // '*lin_watches[toInt(p)]' is a list of constraints watching '~p'.
+
+    // Lazy reasons:
+    //
+    VMap<uint32_t>      lazy_from;        // The row (or 'lazy_card' and the constraint) that implied each variable with the reason 'CRef_Lazy'.
+    vec<CRef>           lazy_clauses;     // Clauses built for lazy reasons and conflicts (freed once not locked).
+    bool                lazy_sweep;       // Some clause in 'lazy_clauses' may no longer be locked.
+    vec<Lit>            lazy_tmp;
+
+    double              max_learnts;      // Limit on the number of local tier learnt clauses.
+    int                 kept_learnts;     // Number of core and mid tier learnts (counted when learnts are removed).
     double              learntsize_adjust_confl;
     int                 learntsize_adjust_cnt;
 
@@ -241,19 +404,69 @@ protected:
     void     insertVarOrder   (Var x);                                                 // Insert a variable in the decision order priority queue.
     Lit      pickBranchLit    ();                                                      // Return the next decision variable.
     void     newDecisionLevel ();                                                      // Begins a new decision level.
-    void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
+    void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef, Lit bin = lit_Undef);    // Enqueue a literal. Assumes value of literal is undefined.
+    void     uncheckedEnqueue (Lit p, int level, CRef from, Lit bin = lit_Undef);      // Enqueue a literal implied at 'level' (possibly below the current level).
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
-    void     cancelUntil      (int level);                                             // Backtrack until a certain level.
-    void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
+    void     cancelUntil      (int level, bool save_phases = true);                    // Backtrack until a certain level.
+    int      conflictLevel    (CRef confl, Lit& forced);                               // Highest level in a conflict, see 'search()'.
+    bool     chronoBT         ()      const;                                           // Is chronological backtracking in use?
+    int      reuseTrail       ();                                                      // The level to restart to if the trail is reused.
+    void     switchMode       ();                                                      // Switch between stable and focused search.
+    int      phaseHeuristic   ()      const;                                           // The decision heuristic of the current phase.
+    void     setHeuristic     (int h);                                                 // Change the decision heuristic.
+    void     lrbUnassign      (Var x);                                                 // Update the LRB activity of an unassigned variable.
+    void     lrbReasoned      (const vec<Lit>& learnt);                                // Count the reason side variables of a learnt clause.
+    bool     useTarget        ()      const;                                           // Decide on the target phase?
+    void     updatePhases     (int consistent);                                        // Update target and best phase from the trail.
+    void     rephase          ();                                                      // Reset the saved phases.
+    void     walk             ();                                                      // Set the saved phases by local search.
+    bool     inprocess        ();                                                      // Simplify between restarts (FALSE means conflict).
+    bool     vivifyLearnts    (uint64_t ticks);                                        // Shorten the core and mid tier learnts (FALSE means conflict).
+    bool     vivify           (CRef cr);                                               // Shorten a clause by propagating its negation.
+    bool     probe            (uint64_t ticks);                                        // Failed literal probing (FALSE means conflict).
+    CRef     probeLit         (Lit p);                                                 // Propagate 'p' at level 1, adding hyper-binary resolvents.
+    bool     failedLit        (Lit p, CRef confl);                                     // Assign '~p' at level 0 after 'p' failed.
+    void     addXor           (const vec<Lit>& ps);                                    // Add the constraint that an odd number of 'ps' is true.
+    void     xorConstraints   (vec<Lit>& out_lits, vec<int>& out_ends) const;          // Append all XOR constraints (as 'xor_lits' and 'xor_ends').
+    bool     gaussBuild       ();                                                      // Set up the XOR matrices at level 0 (FALSE means conflict).
+    CRef     gaussPropagate   (Lit p);                                                 // Propagate the XOR rows watching 'var(p)'.
+    int      gaussScan        (const XorMatrix& m, int r, int skip, int& max_c, bool& parity) const; // An unassigned non-basic column of a row.
+    void     gaussWatch       (XorMatrix& m, int r, int c);                            // Make 'c' the non-basic watch of a row.
+    void     gaussImply       (XorMatrix& m, int r, bool parity, CRef& confl);        // Imply (or check) the basic variable of a row.
+    void     gaussUpdate      (XorMatrix& m, int r, CRef& confl);                      // Restore the watches of a row after it was changed.
+    void     gaussPivot       (XorMatrix& m, int r, int c, CRef& confl);               // Make 'c' the basic column of a row.
+    bool     cardSimplify     ();                                                      // Remove the top-level assignments from the cardinality constraints.
+    CRef     cardPropagate    (Lit p);                                                 // Propagate the cardinality constraints watching '~p'.
+    bool     linearSimplify   ();                                                      // Remove the top-level assignments from the linear constraints.
+    CRef     linearPropagate  (Lit p);                                                 // Propagate the linear constraints watching '~p'.
+    int64_t  linearWatch      (int ci);                                                // Watch more literals of a linear constraint if needed.
+    void     linearImply      (int ci, int64_t sum, CRef& confl);                      // Imply the literals a linear constraint needs.
+    CRef     linearReason     (const Linear& c, Lit p, int64_t room);                  // The reason clause of 'p' (or of a conflict).
+    void     clearLazyReasons ();                                                      // Drop the lazy reasons of the top-level assignments.
+    CRef     lazyReason       (Var x);                                                 // Build the reason clause of an XOR or cardinality implication.
+    void     lazySweep        ();                                                      // Free the clauses of 'lazy_clauses' that are not locked.
+    Var      vmtfNext         ();                                                      // The next VMTF decision variable (or 'var_Undef').
+    void     vmtfBump         ();                                                      // Move the variables of the last conflict to the front.
+    void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel, uint32_t& out_lbd); // (bt = backtrack)
     void     analyzeFinal     (Lit p, LSet& out_conflict);                             // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p);                                                 // (helper method for 'analyze()')
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    void     countKept        ();                                                      // Set 'kept_learnts' after learnts were removed.
+    template<class C>
+    uint32_t computeLBD       (const C& c);                                            // Number of distinct decision levels in 'c'.
+    int      lbdTier          (uint32_t lbd) const;                                    // The database tier of a learnt clause with this LBD.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
     void     rebuildOrderHeap ();
 
+    // Hooks for derived solvers (used for clause sharing by 'ParallelSolver' and inprocessing by 'SimpSolver'):
+    //
+    virtual void exportLearnt (const vec<Lit>& c, uint32_t lbd) { (void)c; (void)lbd; } // Called for each learnt clause.
+    virtual bool importLearnts()                                { return true; }        // Called at level 0 in 'search()'. FALSE means conflict.
+    virtual bool inprocessSimp(uint64_t ticks)                  { (void)ticks; return true; } // Called by 'inprocess()'. FALSE means conflict.
+
     // Maintaining Variable/Clause activity:
     //
     void     varDecayActivity ();                      // Decay all variables with the specified factor. Implemented by increasing the 'bump' value instead.
@@ -266,7 +479,7 @@ protected:
     //
     void     attachClause     (CRef cr);               // Attach a clause to watcher lists.
     void     detachClause     (CRef cr, bool strict = false); // Detach a clause to watcher lists.
-    void     removeClause     (CRef cr);               // Detach and free a clause.
+    void     removeClause     (CRef cr, bool proof_del = true); // Detach and free a clause (and log its deletion).
     bool     isRemoved        (CRef cr) const;         // Test if a clause has been removed.
     bool     locked           (const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
@@ -275,14 +488,27 @@ protected:
     //
     int      decisionLevel    ()      const; // Gives the current decisionlevel.
     uint32_t abstractLevel    (Var x) const; // Used to represent an abstraction of sets of decision levels.
-    CRef     reason           (Var x) const;
+    CRef     reason           (Var x);       // NOTE: may allocate the clause (see 'lazyReason()'), invalidating 'Clause' references.
+    Lit      binReason        (Var x) const; // Other literal of a binary reason clause, or 'lit_Undef'.
     int      level            (Var x) const;
     double   progressEstimate ()      const; // DELETE THIS ?? IT'S NOT VERY USEFUL ...
     bool     withinBudget     ()      const;
     void     relocAll         (ClauseAllocator& to);
 
-    // Static helpers:
+    // Proof logging helpers (all do nothing if no proof is logged):
     //
+    bool     lrat             () const;              // TRUE if proof lines need clause numbers and hints.
+    template<class C>
+    uint64_t proofAdd         (const C& c, const vec<uint64_t>& hints); // Log a derived clause and return its number.
+    void     proofDelete      (const Clause& c);
+    uint64_t takeAddId        ();                    // Number of the clause now being added (see 'add_id').
+    void     proofUnits       ();                    // Log unit clauses for all top-level implications.
+    void     proofChain       (CRef confl, const vec<Lit>& c, vec<uint64_t>& out_hints); // LRAT: hints deriving 'c' from 'confl'.
+    void     proofEmpty       (CRef confl);          // Log the empty clause, following from a top-level conflict.
+
+    // Static helpers (also used by 'Walker', with the seed of the solver):
+    //
+    friend class Walker;
 
     // Returns a random float 0 <= x < 1. Seed must never be 0.
     static inline double drand(double& seed) {
@@ -300,14 +526,55 @@ protected:
 //=================================================================================================
 // Implementation of inline methods:
 
-inline CRef Solver::reason(Var x) const { return vardata[x].reason; }
+inline bool Solver::lrat() const { return proof != NULL && proof->lrat(); }
+
+template<class C>
+inline uint64_t Solver::proofAdd(const C& c, const vec<uint64_t>& hints) {
+    uint64_t id = proof->newId();
+    proof->add(id, (const Lit*)c, c.size(), hints);
+    return id; }
+
+inline void Solver::proofDelete(const Clause& c) {
+    proof->remove(c.has_id() ? c.id() : 0, (const Lit*)c, c.size()); }
+
+inline uint64_t Solver::takeAddId() {
+    uint64_t id = add_id;
+    add_id = 0;
+    return id != 0 || proof == NULL ? id : proof->inputId(); }
+
+inline CRef Solver::reason(Var x) { return vardata[x].reason == CRef_Lazy ? lazyReason(x) : vardata[x].reason; }
 inline int  Solver::level (Var x) const { return vardata[x].level; }
+inline Lit  Solver::binReason(Var x) const { return vardata[x].bin; }
 
 inline void Solver::insertVarOrder(Var x) {
-    if (!order_heap.inHeap(x) && decision[x]) order_heap.insert(x); }
-
-inline void Solver::varDecayActivity() { var_inc *= (1 / var_decay); }
-inline void Solver::varBumpActivity(Var v) { varBumpActivity(v, var_inc); }
+    if (heuristic == branch_vmtf){
+        if (decision[x]) vmtf.unassigned(x);
+    }else if (!order_heap.inHeap(x) && decision[x]) order_heap.insert(x); }
+
+template<class C>
+inline uint32_t Solver::computeLBD(const C& c) {
+    lbd_seen.growTo(decisionLevel()+1, 0);
+    lbd_stamp++;
+    uint32_t lbd = 0;
+    for (int i = 0; i < c.size(); i++){
+        int l = level(var(c[i]));
+        if (lbd_seen[l] != lbd_stamp){
+            lbd_seen[l] = lbd_stamp;
+            lbd++; } }
+    return lbd; }
+
+inline int Solver::lbdTier(uint32_t lbd) const {
+    return (int)lbd <= core_lbd ? tier_core : (int)lbd <= tier2_lbd ? tier_mid : tier_local; }
+
+inline void Solver::varDecayActivity() {
+    if (heuristic == branch_vsids)
+        var_inc *= (1 / var_decay);
+    else if (heuristic == branch_lrb && lrb_step > lrb_step_min)
+        lrb_step -= 1e-6; }
+inline void Solver::varBumpActivity(Var v) {
+    if      (heuristic == branch_vsids) varBumpActivity(v, var_inc);
+    else if (heuristic == branch_vmtf)  vmtf_bumped.push(v);
+    else                                lrb[v].participated++; }
 inline void Solver::varBumpActivity(Var v, double inc) {
     if ( (activity[v] += inc) > 1e100 ) {
         // Rescale:
@@ -333,6 +600,10 @@ inline void Solver::checkGarbage(double gf){
         garbageCollect(); }
 
 // NOTE: enqueue does not set the ok flag! (only public methods do)
+inline void     Solver::uncheckedEnqueue(Lit p, CRef from, Lit bin) { uncheckedEnqueue(p, decisionLevel(), from, bin); }
+inline bool     Solver::chronoBT        ()                const { return chrono >= 0 && !lrat(); }
+inline bool     Solver::useTarget       ()                const { return target_mode == 2 || (target_mode == 1 && !focused); }
+inline int      Solver::phaseHeuristic  ()                const { return restart_mode == 2 && !focused && branch_stable >= 0 ? branch_stable : branching; }
 inline bool     Solver::enqueue         (Lit p, CRef from)      { return value(p) != l_Undef ? value(p) != l_False : (uncheckedEnqueue(p, from), true); }
 inline bool     Solver::addClause       (const vec<Lit>& ps)    { ps.copyTo(add_tmp); return addClause_(add_tmp); }
 inline bool     Solver::addEmptyClause  ()                      { add_tmp.clear(); return addClause_(add_tmp); }
@@ -340,9 +611,22 @@ inline bool     Solver::addClause       (Lit p)                 { add_tmp.clear(
 inline bool     Solver::addClause       (Lit p, Lit q)          { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp); }
 inline bool     Solver::addClause       (Lit p, Lit q, Lit r)   { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); return addClause_(add_tmp); }
 inline bool     Solver::addClause       (Lit p, Lit q, Lit r, Lit s){ add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); add_tmp.push(s); return addClause_(add_tmp); }
+inline bool     Solver::addLinear       (const vec<Lit>& ps, const vec<int64_t>& cs, int64_t k){
+    ps.copyTo(add_tmp); cs.copyTo(coef_tmp); return addLinear_(add_tmp, coef_tmp, k); }
+inline bool     Solver::addAtLeast      (const vec<Lit>& ps, int k){ ps.copyTo(add_tmp); return addAtLeast_(add_tmp, k); }
+inline bool     Solver::addAtMost       (const vec<Lit>& ps, int k){
+    // At most 'k' of 'ps' are true if at least 'ps.size() - k' of their negations are:
+    add_tmp.clear();
+    for (int i = 0; i < ps.size(); i++)
+        add_tmp.push(~ps[i]);
+    return addAtLeast_(add_tmp, ps.size() - k); }
 
 inline bool     Solver::isRemoved       (CRef cr)         const { return ca[cr].mark() == 1; }
-inline bool     Solver::locked          (const Clause& c) const { return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && ca.lea(reason(var(c[0]))) == &c; }
+inline bool     Solver::locked          (const Clause& c) const {
+    // NOTE: binary clauses are propagated without reordering their literals, so the implied literal may be 'c[1]':
+    int i = c.size() == 2 && value(c[0]) != l_True ? 1 : 0;
+    CRef r = vardata[var(c[i])].reason;
+    return value(c[i]) == l_True && r != CRef_Undef && r != CRef_Lazy && ca.lea(r) == &c; }
 inline void     Solver::newDecisionLevel()                      { trail_lim.push(trail.size()); }
 
 inline int      Solver::decisionLevel ()      const   { return trail_lim.size(); }
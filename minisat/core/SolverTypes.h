@@ -24,6 +24,12 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <assert.h>
 
+#if defined(__GNUC__) && defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "minisat/mtl/IntTypes.h"
 #include "minisat/mtl/Alg.h"
 #include "minisat/mtl/Vec.h"
@@ -143,28 +149,43 @@ class Clause {
         unsigned learnt    : 1;
         unsigned has_extra : 1;
         unsigned reloced   : 1;
-        unsigned size      : 27; }                        header;
-    union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
+        unsigned has_id    : 1;
+        unsigned size      : 26; }                        header;
+    union { Lit lit; float act; uint32_t abs; CRef rel;
+            struct { unsigned lbd : 27; unsigned tier : 2; unsigned used : 1; unsigned checked : 1; unsigned vivified : 1; } meta; } data[0];
+
+    // NOTE: the extra field takes two words. In learnt clauses (which always have it) they hold the
+    // activity and the literal block distance and tier information ('meta'), in other clauses the
+    // 64-bit abstraction used for subsumption. When proofs with clause numbers are logged, two more
+    // words holding the clause's proof identifier come last.
 
     friend class ClauseAllocator;
 
     // NOTE: This constructor cannot be used directly (doesn't allocate enough memory).
-    Clause(const vec<Lit>& ps, bool use_extra, bool learnt) {
+    Clause(const vec<Lit>& ps, bool use_extra, bool learnt, bool use_id) {
         header.mark      = 0;
         header.learnt    = learnt;
         header.has_extra = use_extra;
         header.reloced   = 0;
+        header.has_id    = use_id;
         header.size      = ps.size();
 
         for (int i = 0; i < ps.size(); i++) 
             data[i].lit = ps[i];
 
         if (header.has_extra){
-            if (header.learnt)
-                data[header.size].act = 0;
-            else
+            if (header.learnt){
+                data[header.size].act         = 0;
+                data[header.size+1].meta.lbd  = ps.size();
+                data[header.size+1].meta.tier = 0;
+                data[header.size+1].meta.used = 0;
+                data[header.size+1].meta.checked = 0;
+                data[header.size+1].meta.vivified = 0;
+            }else
                 calcAbstraction();
     }
+        if (header.has_id)
+            id(0);
     }
 
     // NOTE: This constructor cannot be used directly (doesn't allocate enough memory).
@@ -176,27 +197,36 @@ class Clause {
             data[i].lit = from[i];
 
         if (header.has_extra){
-            if (header.learnt)
-                data[header.size].act = from.data[header.size].act;
-            else 
-                data[header.size].abs = from.data[header.size].abs;
+            if (header.learnt){
+                data[header.size].act    = from.data[header.size].act;
+                data[header.size+1].meta = from.data[header.size+1].meta;
+            }else{
+                data[header.size].abs   = from.data[header.size].abs;
+                data[header.size+1].abs = from.data[header.size+1].abs; }
     }
+        if (header.has_id)
+            id(from.id());
     }
 
 public:
     void calcAbstraction() {
         assert(header.has_extra);
-        uint32_t abstraction = 0;
+        uint64_t abstraction = 0;
         for (int i = 0; i < size(); i++)
-            abstraction |= 1 << (var(data[i].lit) & 31);
-        data[header.size].abs = abstraction;  }
+            abstraction |= (uint64_t)1 << (var(data[i].lit) & 63);
+        data[header.size].abs   = (uint32_t)abstraction;
+        data[header.size+1].abs = (uint32_t)(abstraction >> 32); }
 
 
     int          size        ()      const   { return header.size; }
-    void         shrink      (int i)         { assert(i <= size()); if (header.has_extra) data[header.size-i] = data[header.size]; header.size -= i; }
+    void         shrink      (int i)         { assert(i <= size());
+        for (int k = 0; k < extra_size(); k++)
+            data[header.size-i+k] = data[header.size+k];
+        header.size -= i; }
     void         pop         ()              { shrink(1); }
     bool         learnt      ()      const   { return header.learnt; }
     bool         has_extra   ()      const   { return header.has_extra; }
+    int          extra_size  ()      const   { return 2*(int)header.has_extra + 2*(int)header.has_id; }
     uint32_t     mark        ()      const   { return header.mark; }
     void         mark        (uint32_t m)    { header.mark = m; }
     const Lit&   last        ()      const   { return data[header.size-1].lit; }
@@ -212,7 +242,28 @@ public:
     operator const Lit* (void) const         { return (Lit*)data; }
 
     float&       activity    ()              { assert(header.has_extra); return data[header.size].act; }
-    uint32_t     abstraction () const        { assert(header.has_extra); return data[header.size].abs; }
+    uint64_t     abstraction () const        { assert(header.has_extra);
+                                               return (uint64_t)data[header.size].abs | ((uint64_t)data[header.size+1].abs << 32); }
+
+    // Learnt clause meta data (literal block distance, database tier, 'recently used' flag and the
+    // 'already checked' and 'already vivified' flags of inprocessing):
+    uint32_t     lbd         () const        { assert(header.learnt); return data[header.size+1].meta.lbd; }
+    void         lbd         (uint32_t l)    { assert(header.learnt); data[header.size+1].meta.lbd = l; }
+    uint32_t     tier        () const        { assert(header.learnt); return data[header.size+1].meta.tier; }
+    void         tier        (uint32_t t)    { assert(header.learnt); data[header.size+1].meta.tier = t; }
+    bool         used        () const        { assert(header.learnt); return data[header.size+1].meta.used; }
+    void         used        (bool u)        { assert(header.learnt); data[header.size+1].meta.used = u; }
+    bool         checked     () const        { assert(header.learnt); return data[header.size+1].meta.checked; }
+    void         checked     (bool c)        { assert(header.learnt); data[header.size+1].meta.checked = c; }
+    bool         vivified    () const        { assert(header.learnt); return data[header.size+1].meta.vivified; }
+    void         vivified    (bool v)        { assert(header.learnt); data[header.size+1].meta.vivified = v; }
+
+    // Proof identifier (see 'Proof'):
+    bool         has_id      () const        { return header.has_id; }
+    uint64_t     id          () const        { assert(header.has_id); int k = header.size + 2*header.has_extra;
+                                               return (uint64_t)data[k].abs | ((uint64_t)data[k+1].abs << 32); }
+    void         id          (uint64_t i)    { assert(header.has_id); int k = header.size + 2*header.has_extra;
+                                               data[k].abs = (uint32_t)i; data[k+1].abs = (uint32_t)(i >> 32); }
 
     Lit          subsumes    (const Clause& other) const;
     void         strengthen  (Lit p);
@@ -223,23 +274,26 @@ public:
 // ClauseAllocator -- a simple class for allocating memory for clauses:
 
 const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
+const CRef CRef_Lazy  = CRef_Undef - 1;  // The reason of an implication not made by a clause (see 'Solver::reason()').
 class ClauseAllocator
 {
     RegionAllocator<uint32_t> ra;
 
-    static uint32_t clauseWord32Size(int size, bool has_extra){
-        return (sizeof(Clause) + (sizeof(Lit) * (size + (int)has_extra))) / sizeof(uint32_t); }
+    static uint32_t clauseWord32Size(int size, int extra_size){
+        return (sizeof(Clause) + (sizeof(Lit) * (size + extra_size))) / sizeof(uint32_t); }
 
  public:
     enum { Unit_Size = RegionAllocator<uint32_t>::Unit_Size };
 
     bool extra_clause_field;
+    bool clause_ids;            // Give new clauses room for a proof identifier.
 
-    ClauseAllocator(uint32_t start_cap) : ra(start_cap), extra_clause_field(false){}
-    ClauseAllocator() : extra_clause_field(false){}
+    ClauseAllocator(uint32_t start_cap) : ra(start_cap), extra_clause_field(false), clause_ids(false){}
+    ClauseAllocator() : extra_clause_field(false), clause_ids(false){}
 
     void moveTo(ClauseAllocator& to){
         to.extra_clause_field = extra_clause_field;
+        to.clause_ids         = clause_ids;
         ra.moveTo(to.ra); }
 
     CRef alloc(const vec<Lit>& ps, bool learnt = false)
@@ -247,8 +301,8 @@ class ClauseAllocator
         assert(sizeof(Lit)      == sizeof(uint32_t));
         assert(sizeof(float)    == sizeof(uint32_t));
         bool use_extra = learnt | extra_clause_field;
-        CRef cid       = ra.alloc(clauseWord32Size(ps.size(), use_extra));
-        new (lea(cid)) Clause(ps, use_extra, learnt);
+        CRef cid       = ra.alloc(clauseWord32Size(ps.size(), 2*(int)use_extra + 2*(int)clause_ids));
+        new (lea(cid)) Clause(ps, use_extra, learnt, clause_ids);
 
         return cid;
     }
@@ -256,10 +310,17 @@ class ClauseAllocator
     CRef alloc(const Clause& from)
     {
         bool use_extra = from.learnt() | extra_clause_field;
-        CRef cid       = ra.alloc(clauseWord32Size(from.size(), use_extra));
+        CRef cid       = ra.alloc(clauseWord32Size(from.size(), 2*(int)use_extra + 2*(int)from.has_id()));
         new (lea(cid)) Clause(from, use_extra);
         return cid; }
 
+    // Make room for 'n_clauses' more problem clauses with 'n_lits' literals in total (requests that
+    // could never fit are ignored):
+    void reserve(int n_clauses, uint64_t n_lits){
+        uint64_t words = (uint64_t)clauseWord32Size(0, 2*(int)extra_clause_field + 2*(int)clause_ids) * (uint64_t)n_clauses + n_lits;
+        if (words < CRef_Lazy - ra.size())
+            ra.reserve((uint32_t)words); }
+
     uint32_t size      () const      { return ra.size(); }
     uint32_t wasted    () const      { return ra.wasted(); }
 
@@ -273,7 +334,7 @@ class ClauseAllocator
     void free(CRef cid)
     {
         Clause& c = operator[](cid);
-        ra.free(clauseWord32Size(c.size(), c.has_extra()));
+        ra.free(clauseWord32Size(c.size(), c.extra_size()));
     }
 
     void reloc(CRef& cr, ClauseAllocator& to)
@@ -336,6 +397,7 @@ class OccLists
         deleted(d){}
     
     void  init      (const K& idx){ occs.reserve(idx); occs[idx].clear(); dirty.reserve(idx, 0); }
+    void  capacity  (const K& idx){ occs.capacity(idx); dirty.capacity(idx); }
     Vec&  operator[](const K& idx){ return occs[idx]; }
     Vec&  lookup    (const K& idx){ if (dirty[idx]) clean(idx); return occs[idx]; }
 
@@ -422,6 +484,40 @@ class CMap
 };
 
 
+// Returns the index of the literal in 'ps' (of size 'n') over the same variable as 'p', or 'n' if
+// there is none. Uses AVX2 or SSE2 vector compares when the compiler targets them:
+inline int findVar(const Lit* ps, int n, Lit p)
+{
+    const int* xs = (const int*)ps;
+    int        x  = toInt(p) | 1;
+    int        i  = 0;
+#if defined(__GNUC__) && defined(__AVX2__)
+    const __m256i key8 = _mm256_set1_epi32(x);
+    const __m256i one8 = _mm256_set1_epi32(1);
+    for (; i + 8 <= n; i += 8){
+        __m256i xs8  = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(xs + i)), one8);
+        int     mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(xs8, key8)));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+#if defined(__GNUC__) && (defined(__AVX2__) || defined(__SSE2__))
+    const __m128i key4 = _mm_set1_epi32(x);
+    const __m128i one4 = _mm_set1_epi32(1);
+    for (; i + 4 <= n; i += 4){
+        __m128i xs4  = _mm_or_si128(_mm_loadu_si128((const __m128i*)(xs + i)), one4);
+        int     mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(xs4, key4)));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < n; i++)
+        if ((xs[i] | 1) == x)
+            return i;
+    return n;
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  subsumes : (other : const Clause&)  ->  Lit
@@ -437,30 +533,24 @@ class CMap
 |________________________________________________________________________________________________@*/
 inline Lit Clause::subsumes(const Clause& other) const
 {
-    //if (other.size() < size() || (extra.abst & ~other.extra.abst) != 0)
-    //if (other.size() < size() || (!learnt() && !other.learnt() && (extra.abst & ~other.extra.abst) != 0))
     assert(!header.learnt);   assert(!other.header.learnt);
     assert(header.has_extra); assert(other.header.has_extra);
-    if (other.header.size < header.size || (data[header.size].abs & ~other.data[other.header.size].abs) != 0)
+    if (other.header.size < header.size || (abstraction() & ~other.abstraction()) != 0)
         return lit_Error;
 
     Lit        ret = lit_Undef;
     const Lit* c   = (const Lit*)(*this);
     const Lit* d   = (const Lit*)other;
-
-    for (unsigned i = 0; i < header.size; i++) {
-        // search for c[i] or ~c[i]
-        for (unsigned j = 0; j < other.header.size; j++)
-            if (c[i] == d[j])
-                goto ok;
-            else if (ret == lit_Undef && c[i] == ~d[j]){
-                ret = c[i];
-                goto ok;
-            }
-
-        // did not find it
-        return lit_Error;
-    ok:;
+    int        n   = other.header.size;
+
+    // Since 'other' is not a tautology, the literal over the same variable as c[i] is either c[i]
+    // or ~c[i]:
+    for (unsigned i = 0; i < header.size; i++){
+        int j = findVar(d, n, c[i]);
+        if (j == n || (d[j] != c[i] && ret != lit_Undef))
+            return lit_Error;
+        else if (d[j] != c[i])
+            ret = c[i];
     }
 
     return ret;
@@ -0,0 +1,98 @@
+/******************************************************************************************[Vmtf.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Vmtf_h
+#define Minisat_Vmtf_h
+
+#include "minisat/mtl/IntMap.h"
+#include "minisat/core/SolverTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// Vmtf -- a variable-move-to-front decision queue:
+//
+// Variables are kept in a doubly linked list ordered by the time they were last bumped. Bumping
+// moves a variable to the end of the list in constant time. The next decision is the most recently
+// bumped unassigned variable. It is searched for backwards from a cached position, after which all
+// variables are assigned. Unassigning a variable moves that position only if the variable was
+// bumped more recently, so the search is amortised constant time.
+
+class Vmtf {
+    struct Link { Var prev, next; };
+
+    VMap<Link>      links;
+    VMap<uint64_t>  stamps;     // The time each variable was last bumped.
+    Var             first;      // The least recently bumped variable.
+    Var             last;       // The most recently bumped variable.
+    Var             search;     // All variables after this one are assigned.
+    uint64_t        stamp;
+
+    void unlink(Var v){
+        Link& l = links[v];
+        if (l.prev != var_Undef) links[l.prev].next = l.next; else first = l.next;
+        if (l.next != var_Undef) links[l.next].prev = l.prev; else last  = l.prev; }
+
+    void append(Var v){
+        Link& l = links[v];
+        l.prev = last;
+        l.next = var_Undef;
+        if (last != var_Undef) links[last].next = v; else first = v;
+        last      = v;
+        stamps[v] = ++stamp; }
+
+ public:
+    Vmtf() : first(var_Undef), last(var_Undef), search(var_Undef), stamp(0) {}
+
+    uint64_t operator[](Var v) const { return stamps[v]; }
+    Var      next      ()      const { return search; }          // Start of the search for the next decision.
+    Var      prev      (Var v) const { return links[v].prev; }
+    void     setNext   (Var v)       { search = v; }             // Cache the result of a search.
+    void     reset     ()            { search = last; }
+
+    // Add a new variable (or re-add a released one) at the end:
+    void     insert    (Var v){
+        if (links.has(v))
+            unlink(v);
+        else{
+            Link l = { var_Undef, var_Undef };
+            links .insert(v, l);
+            stamps.insert(v, 0); }
+        append(v);
+        search = v; }
+
+    // Move an assigned variable to the end:
+    void     bump      (Var v){
+        if (v == last) return;
+        if (v == search) search = links[v].prev;
+        unlink(v);
+        append(v); }
+
+    // Notify the queue that a variable has become unassigned:
+    void     unassigned(Var v){ if (search == var_Undef || stamps[v] > stamps[search]) search = v; }
+
+    void     capacity  (Var v){ links.capacity(v); stamps.capacity(v); }
+};
+
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,213 @@
+/*****************************************************************************************[Walk.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <math.h>
+
+#include "minisat/core/Walk.h"
+#include "minisat/core/Solver.h"
+
+using namespace Minisat;
+
+Walker::Walker(int nvars, double& s)
+  : best_trail(0)
+  , tracking  (true)
+  , max_size  (0)
+  , seed      (s)
+  , flips     (0)
+{
+    vals.growTo(nvars, 0);
+    starts.push(0);
+}
+
+
+void Walker::addClause(const vec<Lit>& c)
+{
+    for (int i = 0; i < c.size(); i++)
+        lits.push(c[i]);
+    starts.push(lits.size());
+    if (c.size() > max_size)
+        max_size = c.size();
+}
+
+
+// Build the occurrence lists and the counters of the initial assignment:
+void Walker::init()
+{
+    int nclauses = starts.size() - 1;
+
+    occ_starts.clear();
+    occ_starts.growTo(2 * vals.size() + 1, 0);
+    for (int i = 0; i < lits.size(); i++)
+        occ_starts[toInt(lits[i]) + 1]++;
+    for (int i = 1; i < occ_starts.size(); i++)
+        occ_starts[i] += occ_starts[i-1];
+    occs.growTo(lits.size());
+    for (int c = 0; c < nclauses; c++)
+        for (int i = starts[c]; i < starts[c+1]; i++)
+            occs[occ_starts[toInt(lits[i])]++] = c;
+    for (int i = occ_starts.size() - 1; i > 0; i--)
+        occ_starts[i] = occ_starts[i-1];
+    occ_starts[0] = 0;
+
+    num_true .growTo(nclauses);
+    critical .growTo(nclauses);
+    unsat_pos.growTo(nclauses);
+    breaks.clear();
+    breaks.growTo(vals.size(), 0);
+    unsat.clear();
+    for (int c = 0; c < nclauses; c++){
+        int n = 0;
+        Var x = 0;
+        for (int i = starts[c]; i < starts[c+1]; i++)
+            if (isTrue(lits[i])){
+                n++;
+                x ^= var(lits[i]); }
+        num_true[c] = n;
+        critical[c] = x;
+        if (n == 0)
+            makeUnsat(c);
+        else if (n == 1)
+            breaks[x]++;
+    }
+
+    // The polynomial break weights of ProbSAT, with the constants it uses for each clause size:
+    static const double cbs[] = { 2.06, 3.0, 3.7, 5.1, 5.4 };
+    double cb = cbs[max_size <= 3 ? 0 : max_size >= 7 ? 4 : max_size - 3];
+    scores.clear();
+    for (int b = 0; b < 64; b++)
+        scores.push(pow(0.9 + b, -cb));
+}
+
+
+void Walker::makeSat(int c)
+{
+    int i    = unsat_pos[c];
+    int last = unsat.last();
+    unsat[i]        = last;
+    unsat_pos[last] = i;
+    unsat.pop();
+}
+
+
+void Walker::makeUnsat(int c)
+{
+    unsat_pos[c] = unsat.size();
+    unsat.push(c);
+}
+
+
+void Walker::flip(Var v)
+{
+    vals[v] = !vals[v];
+    Lit t   = mkLit(v, vals[v]);
+
+    // Clauses where 'v' is now true:
+    for (int i = occ_starts[toInt(t)]; i < occ_starts[toInt(t)+1]; i++){
+        int c = occs[i];
+        if (num_true[c]++ == 0){
+            makeSat(c);
+            critical[c] = v;
+            breaks[v]++;
+        }else{
+            if (num_true[c] == 2)
+                breaks[critical[c]]--;
+            critical[c] ^= v;
+        }
+    }
+
+    // Clauses where 'v' is now false:
+    for (int i = occ_starts[toInt(~t)]; i < occ_starts[toInt(~t)+1]; i++){
+        int c = occs[i];
+        critical[c] ^= v;
+        if (--num_true[c] == 0){
+            makeUnsat(c);
+            breaks[v]--;
+        }else if (num_true[c] == 1)
+            breaks[critical[c]]++;
+    }
+}
+
+
+// The current assignment is the best so far. While the trail is tracked this is only a matter of
+// remembering its length, otherwise the assignment is copied and tracking starts over.
+void Walker::saveBest()
+{
+    if (tracking)
+        best_trail = trail.size();
+    else{
+        vals.copyTo(best);
+        trail.clear();
+        best_trail = 0;
+        tracking   = true;
+    }
+}
+
+
+int Walker::walk(uint64_t max_flips)
+{
+    init();
+    vals.copyTo(best);
+    trail.clear();
+    best_trail = 0;
+    tracking   = true;
+
+    int best_unsat = unsat.size();
+    for (uint64_t n = 0; n < max_flips && unsat.size() > 0; n++){
+        int c = unsat[Solver::irand(seed, unsat.size())];
+
+        // Pick a variable of the clause with a probability proportional to the weight of its break count:
+        double sum = 0;
+        probs.clear();
+        for (int i = starts[c]; i < starts[c+1]; i++){
+            int    b = breaks[var(lits[i])];
+            double p = scores[b < scores.size() ? b : scores.size() - 1];
+            probs.push(p);
+            sum += p; }
+        double r = Solver::drand(seed) * sum;
+        int    k = 0;
+        while (k < probs.size() - 1 && r >= probs[k])
+            r -= probs[k++];
+
+        Var v = var(lits[starts[c] + k]);
+        flip(v);
+        flips++;
+        if (tracking)
+            trail.push(v);
+
+        if (unsat.size() < best_unsat){
+            best_unsat = unsat.size();
+            saveBest();
+        }else if (tracking && trail.size() > vals.size() / 4){
+            // Keep the trail short, the next best assignment will be copied instead:
+            for (int i = 0; i < best_trail; i++)
+                best[trail[i]] = !best[trail[i]];
+            trail.clear();
+            best_trail = 0;
+            tracking   = false;
+        }
+    }
+
+    for (int i = 0; i < best_trail; i++)
+        best[trail[i]] = !best[trail[i]];
+    trail.clear();
+    best_trail = 0;
+
+    return best_unsat;
+}
@@ -0,0 +1,80 @@
+/******************************************************************************************[Walk.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Walk_h
+#define Minisat_Walk_h
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+
+namespace Minisat {
+
+//=================================================================================================
+// Walker -- a ProbSAT local search, used to find phases that satisfy as many clauses as possible:
+//
+// The clauses are copied into one flat literal array, with the occurrences of each literal stored
+// in a second one. For each clause, the number of true literals and the XOR of their variables
+// is maintained, which is the critical variable once only one is left. This keeps the break count
+// of every variable up to date, so a flip only visits the occurrences of the flipped variable.
+
+class Walker {
+    vec<Lit>    lits;        // The literals of all clauses, one clause after the other.
+    vec<int>    starts;      // Where each clause starts in 'lits' (with the end as an extra entry).
+    vec<int>    occ_starts;  // Where the occurrences of each literal start in 'occs'.
+    vec<int>    occs;        // The clauses of each literal, one literal after the other.
+    vec<int>    num_true;    // The number of true literals of each clause.
+    vec<Var>    critical;    // The XOR of the true variables of each clause.
+    vec<int>    breaks;      // The number of clauses each variable is the only true variable of.
+    vec<int>    unsat;       // The falsified clauses..
+    vec<int>    unsat_pos;   // .. and their positions in 'unsat'.
+    vec<char>   vals;        // The current assignment ('mkLit(v, vals[v])' is true).
+    vec<char>   best;        // The assignment with the fewest falsified clauses (see 'trail').
+    vec<Var>    trail;       // The flipped variables since 'best' was last updated..
+    int         best_trail;  // .. of which this many are part of the best assignment.
+    bool        tracking;    // Set if 'trail' is complete (else 'best' needs a full copy).
+    vec<double> scores;      // The probability weight of each break count.
+    vec<double> probs;       // Temporary.
+    int         max_size;
+    double&     seed;
+
+    bool     isTrue (Lit p) const { return sign(p) == (bool)vals[var(p)]; }
+    void     makeSat(int c);
+    void     makeUnsat(int c);
+    void     flip   (Var v);
+    void     init   ();
+    void     saveBest();
+
+ public:
+    uint64_t flips;          // Statistics.
+
+    Walker(int nvars, double& seed);
+
+    void     addClause(const vec<Lit>& c);             // Add a clause (without false literals).
+    void     setPhase (Var v, bool s) { vals[v] = s; } // Set the initial value of a variable.
+    int      walk     (uint64_t max_flips);            // Search, return the fewest falsified clauses.
+    bool     phase    (Var v) const { return best[v]; } // The best assignment found by 'walk()'.
+};
+
+
+//=================================================================================================
+}
+
+#endif
@@ -58,6 +58,7 @@ class RegionAllocator
 
     Ref      alloc     (int size); 
     void     free      (int size)    { wasted_ += size; }
+    void     reserve   (uint32_t size);  // Make room for 'size' more units without reallocating.
 
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
     T&       operator[](Ref r)       { assert(r < sz); return memory[r]; }
@@ -88,21 +89,32 @@ void RegionAllocator<T>::capacity(uint32_t min_cap)
     if (cap >= min_cap) return;
 
     uint32_t prev_cap = cap;
-    while (cap < min_cap){
+    uint32_t new_cap  = cap;
+    while (new_cap < min_cap){
         // NOTE: Multiply by a factor (13/8) without causing overflow, then add 2 and make the
         // result even by clearing the least significant bit. The resulting sequence of capacities
         // is carefully chosen to hit a maximum capacity that is close to the '2^32-1' limit when
         // using 'uint32_t' as indices so that as much as possible of this space can be used.
-        uint32_t delta = ((cap >> 1) + (cap >> 3) + 2) & ~1;
-        cap += delta;
+        uint32_t delta = ((new_cap >> 1) + (new_cap >> 3) + 2) & ~1;
+        new_cap += delta;
 
-        if (cap <= prev_cap)
+        if (new_cap <= prev_cap)
             throw OutOfMemoryException();
     }
-    // printf(" .. (%p) cap = %u\n", this, cap);
+    // printf(" .. (%p) cap = %u\n", this, new_cap);
 
-    assert(cap > 0);
-    memory = (T*)xrealloc(memory, sizeof(T)*cap);
+    assert(new_cap > 0);
+    memory = (T*)xrealloc(memory, sizeof(T)*new_cap);    // (unchanged if this throws)
+    cap    = new_cap;
+}
+
+
+template<class T>
+void RegionAllocator<T>::reserve(uint32_t size)
+{
+    if (sz + size < sz)
+        throw OutOfMemoryException();
+    capacity(sz + size);
 }
 
 
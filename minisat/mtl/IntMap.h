@@ -46,6 +46,7 @@ namespace Minisat {
 
         void     reserve(K key, V pad)       { map.growTo(index(key)+1, pad); }
         void     reserve(K key)              { map.growTo(index(key)+1); }
+        void     capacity(K key)             { map.capacity(index(key)+1); }  // Make room without growing.
         void     insert (K key, V val, V pad){ reserve(key, pad); operator[](key) = val; }
         void     insert (K key, V val)       { reserve(key); operator[](key) = val; }
 
@@ -59,6 +59,7 @@ public:
 
     // Pointer to first element:
     operator T*       (void)           { return data; }
+    operator const T* (void) const     { return data; }
 
     // Size operations:
     Size     size     (void) const   { return sz; }
@@ -99,9 +100,10 @@ void vec<T,_Size>::capacity(Size min_cap) {
     if (cap >= min_cap) return;
     Size add = max((min_cap - cap + 1) & ~1, ((cap >> 1) + 2) & ~1);   // NOTE: grow by approximately 3/2
     const Size size_max = std::numeric_limits<Size>::max();
-    if ( ((size_max <= std::numeric_limits<int>::max()) && (add > size_max - cap))
-    ||   (((data = (T*)::realloc(data, (cap += add) * sizeof(T))) == NULL) && errno == ENOMEM) )
+    if ((size_max <= std::numeric_limits<int>::max()) && (add > size_max - cap))
         throw OutOfMemoryException();
+    data = (T*)xrealloc(data, (cap + add) * sizeof(T));    // (unchanged if this throws)
+    cap += add;
  }
 
 
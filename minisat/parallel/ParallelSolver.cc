@@ -0,0 +1,405 @@
+/*******************************************************************************[ParallelSolver.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <thread>
+
+#include "minisat/parallel/ParallelSolver.h"
+#include "minisat/utils/System.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Options:
+
+
+static const char* _cat = "PARALLEL";
+
+static IntOption    opt_threads          (_cat, "threads",      "Number of solver threads (0 means one per hardware thread).", 0, IntRange(0, 1024));
+static IntOption    opt_share_size       (_cat, "share-size",   "Share learnt clauses with at most this many literals.", 8, IntRange(0, INT32_MAX));
+static IntOption    opt_share_lbd        (_cat, "share-lbd",    "Share learnt clauses with at most this LBD.", 4, IntRange(0, INT32_MAX));
+
+
+//=================================================================================================
+// ClauseRing -- a lock-free single producer, multiple consumer buffer of learnt clauses:
+//
+// Each clause is stored as its size, its LBD and its literals. Consumers keep their own read
+// position. A consumer that falls behind by more than the buffer size simply loses clauses. Since
+// the producer never waits, a consumer may see data that is overwritten while it reads it. This is
+// detected (as in a sequence lock) by checking 'reserved' after reading.
+
+class ParallelSolver::ClauseRing {
+    enum { ring_size = 1 << 20 };      // In words, must be a power of two.
+
+    std::atomic<uint32_t>* data;
+    std::atomic<uint64_t>  head;       // End of the published data.
+    std::atomic<uint64_t>  reserved;   // End of the data being written (ahead of 'head' during 'push()').
+
+ public:
+    ClauseRing() : data(new std::atomic<uint32_t>[ring_size]), head(0), reserved(0) {}
+    ~ClauseRing() { delete [] data; }
+
+    // Producer:
+    void push(const vec<Lit>& c, uint32_t lbd)
+    {
+        uint64_t h   = head.load(std::memory_order_relaxed);
+        uint64_t end = h + c.size() + 2;
+        if (end - h > ring_size) return;
+
+        reserved.store(end, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        data[ h    & (ring_size-1)].store(c.size(), std::memory_order_relaxed);
+        data[(h+1) & (ring_size-1)].store(lbd,      std::memory_order_relaxed);
+        for (int i = 0; i < c.size(); i++)
+            data[(h+2+i) & (ring_size-1)].store(toInt(c[i]), std::memory_order_relaxed);
+
+        head.store(end, std::memory_order_release);
+    }
+
+    // Consumer: read the clause at 'pos' into 'out' and advance 'pos'. Returns FALSE if there are no
+    // more (valid) clauses to read.
+    bool pull(uint64_t& pos, vec<Lit>& out, uint32_t& lbd) const
+    {
+        uint64_t h = head.load(std::memory_order_acquire);
+        if (pos == h) return false;
+
+        uint32_t size = data[pos & (ring_size-1)].load(std::memory_order_relaxed);
+        if (h - pos > ring_size || size + 2 > h - pos){
+            // Fell behind (or read garbage), skip to the end:
+            pos = h;
+            return false; }
+
+        lbd = data[(pos+1) & (ring_size-1)].load(std::memory_order_relaxed);
+        out.clear();
+        for (uint32_t i = 0; i < size; i++)
+            out.push(toLit(data[(pos+2+i) & (ring_size-1)].load(std::memory_order_relaxed)));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (reserved.load(std::memory_order_relaxed) - pos > ring_size){
+            // Overwritten while reading:
+            pos = head.load(std::memory_order_acquire);
+            return false; }
+
+        pos += size + 2;
+        return true;
+    }
+};
+
+
+//=================================================================================================
+// Worker -- one diversified solver instance:
+
+
+class ParallelSolver::Worker : public Solver {
+    ParallelSolver& master;
+    int             id;
+    vec<uint64_t>   import_pos;        // Read position in the clause ring of each other worker.
+    vec<Lit>        import_tmp;
+
+    bool addImported(vec<Lit>& ps, uint32_t lbd);
+
+ protected:
+    void exportLearnt (const vec<Lit>& c, uint32_t lbd);
+    bool importLearnts();
+
+ public:
+    lbool    status;
+    uint64_t exported, imported;
+
+    Worker(ParallelSolver& m, int i);
+    void run();
+};
+
+
+ParallelSolver::Worker::Worker(ParallelSolver& m, int i) : master(m), id(i), status(l_Undef), exported(0), imported(0)
+{
+    import_pos.growTo(master.rings.size(), 0);
+
+    // Diversify the search. The first worker keeps the user settings:
+    static const double var_decays[] = { 0.95, 0.85, 0.90, 0.99 };
+    if (id > 0){
+        random_seed  = master.random_seed + id * 1000003;
+        rnd_init_act = true;
+        var_decay    = var_decays[id % 4];
+        luby_restart = (id % 2 == 0) == master.luby_restart;
+        phase_saving = 2 - (id / 2) % 3;
+    }else{
+        random_seed  = master.random_seed;
+        var_decay    = master.var_decay;
+        luby_restart = master.luby_restart;
+        phase_saving = master.phase_saving;
+    }
+    core_lbd  = master.core_lbd;
+    tier2_lbd = master.tier2_lbd;
+
+    // Clauses of the other workers are only imported on level 0, which is rarely reached on
+    // restarts if the trail is reused:
+    reuse_trail = false;
+
+    // Resource constraints are inherited from the master:
+    conflict_budget    = master.conflict_budget    < 0 ? -1 : master.conflict_budget    - master.conflicts;
+    propagation_budget = master.propagation_budget < 0 ? -1 : master.propagation_budget - master.propagations;
+}
+
+
+void ParallelSolver::Worker::run()
+{
+    // Copy the (simplified) problem of the master:
+    for (Var v = 0; v < master.nVars(); v++)
+        newVar(master.user_pol[v], master.decision[v]);
+
+    for (int i = 0; i < master.trail.size() && ok; i++)
+        addClause(master.trail[i]);
+
+    vec<Lit> ps;
+    for (int i = 0; i < master.clauses.size() && ok; i++)
+        if (!master.isRemoved(master.clauses[i])){
+            const Clause& c = master.ca[master.clauses[i]];
+            ps.clear();
+            for (int j = 0; j < c.size(); j++)
+                ps.push(c[j]);
+            addClause_(ps);
+        }
+    master.xorConstraints(xor_lits, xor_ends);
+    for (int i = 0; i < master.cards.size() && ok; i++){
+        const Card& c = master.cards[i];
+        ps.clear();
+        for (int j = 0; j < c.size; j++)
+            ps.push(master.card_lits[c.first + j]);
+        addAtLeast_(ps, c.bound);
+    }
+    vec<int64_t> cs;
+    for (int i = 0; i < master.linears.size() && ok; i++){
+        const Linear& c = master.linears[i];
+        ps.clear();
+        cs.clear();
+        for (int j = 0; j < c.size; j++){
+            ps.push(master.lin_lits [c.first + j]);
+            cs.push(master.lin_coefs[c.first + j]); }
+        addLinear_(ps, cs, c.bound);
+    }
+
+    status = solveLimited(master.assumptions);
+
+    // The first worker to finish stops the others:
+    int none = -1;
+    if (status != l_Undef && master.first_done.compare_exchange_strong(none, id))
+        for (int i = 0; i < master.workers.size(); i++)
+            if (i != id)
+                master.workers[i]->interrupt();
+}
+
+
+void ParallelSolver::Worker::exportLearnt(const vec<Lit>& c, uint32_t lbd)
+{
+    if (master.asynch_interrupt) interrupt();
+
+    if (c.size() <= master.share_size || (int)lbd <= master.share_lbd){
+        master.rings[id]->push(c, lbd);
+        exported++; }
+}
+
+
+bool ParallelSolver::Worker::importLearnts()
+{
+    if (master.asynch_interrupt) interrupt();
+
+    uint32_t lbd;
+    for (int i = 0; i < master.rings.size(); i++)
+        if (i != id)
+            while (master.rings[i]->pull(import_pos[i], import_tmp, lbd))
+                if (!addImported(import_tmp, lbd))
+                    return false;
+    return true;
+}
+
+
+// Attach an imported clause as a learnt clause (at decision level 0). Returns FALSE on conflict.
+bool ParallelSolver::Worker::addImported(vec<Lit>& ps, uint32_t lbd)
+{
+    assert(decisionLevel() == 0);
+    imported++;
+
+    // Check if clause is satisfied and remove false literals:
+    int i, j;
+    for (i = j = 0; i < ps.size(); i++)
+        if (value(ps[i]) == l_True)
+            return true;
+        else if (value(ps[i]) == l_Undef)
+            ps[j++] = ps[i];
+    ps.shrink(i - j);
+
+    if (ps.size() == 0)
+        return false;
+    else if (ps.size() == 1){
+        uncheckedEnqueue(ps[0]);
+        return propagate() == CRef_Undef;
+    }else{
+        if ((int)lbd > ps.size()) lbd = ps.size();
+        CRef cr = ca.alloc(ps, true);
+        ca[cr].lbd(lbd);
+        ca[cr].tier(lbdTier(lbd));
+        learnts.push(cr);
+        attachClause(cr);
+    }
+
+    return true;
+}
+
+
+//=================================================================================================
+// Constructor/Destructor:
+
+
+ParallelSolver::ParallelSolver() :
+    threads            (opt_threads)
+  , share_size         (opt_share_size)
+  , share_lbd          (opt_share_lbd)
+  , winner             (-1)
+  , exported           (0)
+  , imported           (0)
+  , first_done         (-1)
+{}
+
+
+ParallelSolver::~ParallelSolver()
+{
+}
+
+
+//=================================================================================================
+// Solving:
+
+
+lbool ParallelSolver::solve_(bool do_simp, bool turn_off_simp)
+{
+    vec<Var> extra_frozen;
+    lbool    result = l_True;
+
+    do_simp &= use_simplification;
+
+    if (do_simp){
+        // Assumptions must be temporarily frozen to run variable elimination:
+        for (int i = 0; i < assumptions.size(); i++){
+            Var v = var(assumptions[i]);
+
+            // If an assumption has been eliminated, remember it.
+            assert(!isEliminated(v));
+
+            if (!frozen[v]){
+                // Freeze and store.
+                setFrozen(v, true);
+                extra_frozen.push(v);
+            } }
+
+        result = lbool(eliminate(turn_off_simp));
+    }
+
+    // NOTE: a proof is a single sequence of steps, so proof logging runs the search sequentially.
+    if (result == l_True)
+        result = proof != NULL ? Solver::solve_() : solveParallel_();
+    else if (verbosity >= 1)
+        printf("===============================================================================\n");
+
+    if (result == l_True && extend_model)
+        extendModel();
+
+    if (do_simp)
+        // Unfreeze the assumptions that were frozen:
+        for (int i = 0; i < extra_frozen.size(); i++)
+            setFrozen(extra_frozen[i], false);
+
+    return result;
+}
+
+
+lbool ParallelSolver::solveParallel_()
+{
+    model.clear();
+    conflict.clear();
+    if (!ok) return l_False;
+
+    solves++;
+
+    int n = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+    if (n < 1) n = 1;
+
+    if (verbosity >= 1){
+        printf("============================[ Parallel Search ]================================\n");
+        printf("|  Threads:              %12d                                         |\n", n);
+        printf("===============================================================================\n");
+    }
+
+    first_done = -1;
+    for (int i = 0; i < n; i++)
+        rings.push(new ClauseRing());
+    for (int i = 0; i < n; i++)
+        workers.push(new Worker(*this, i));
+
+    std::thread* ts = new std::thread[n];
+    for (int i = 0; i < n; i++)
+        ts[i] = std::thread(&Worker::run, workers[i]);
+    for (int i = 0; i < n; i++)
+        ts[i].join();
+    delete [] ts;
+
+    lbool status = l_Undef;
+    winner       = first_done;
+    if (winner >= 0){
+        Worker& w = *workers[winner];
+        status = w.status;
+        if (status == l_True)
+            w.model.copyTo(model);
+        else if (status == l_False){
+            for (int i = 0; i < w.conflict.size(); i++)
+                conflict.insert(w.conflict[i]);
+            if (conflict.size() == 0)
+                ok = false;
+        }
+    }
+
+    // Accumulate statistics and clean up:
+    for (int i = 0; i < n; i++){
+        Worker& w = *workers[i];
+        starts       += w.starts;
+        decisions    += w.decisions;
+        rnd_decisions+= w.rnd_decisions;
+        propagations += w.propagations;
+        conflicts    += w.conflicts;
+        max_literals += w.max_literals;
+        tot_literals += w.tot_literals;
+        exported     += w.exported;
+        imported     += w.imported;
+        delete workers[i];
+        delete rings[i];
+    }
+    workers.clear();
+    rings.clear();
+
+    return status;
+}
+
+
+void ParallelSolver::printStats() const
+{
+    Solver::printStats();
+    printf("winning thread        : %d\n", winner);
+    printf("shared clauses        : %-12" PRIu64 "   (%" PRIu64 " imported)\n", exported, imported);
+}
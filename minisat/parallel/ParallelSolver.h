@@ -0,0 +1,100 @@
+/********************************************************************************[ParallelSolver.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_ParallelSolver_h
+#define Minisat_ParallelSolver_h
+
+#include <atomic>
+
+#include "minisat/simp/SimpSolver.h"
+
+
+namespace Minisat {
+
+//=================================================================================================
+// ParallelSolver -- a portfolio of diversified solvers sharing learnt clauses:
+//
+// The problem is simplified once (as in 'SimpSolver'). The resulting clause set is then copied into
+// one core 'Solver' per thread. The threads differ in their search parameters and exchange short
+// or low LBD learnt clauses. The first thread to finish interrupts the others, and its model (or
+// final conflict) is reported by the 'ParallelSolver' object itself.
+
+class ParallelSolver : public SimpSolver {
+ public:
+    // Constructor/Destructor:
+    //
+    ParallelSolver();
+    ~ParallelSolver();
+
+    // Solving:
+    //
+    bool    solve       (const vec<Lit>& assumps, bool do_simp = true, bool turn_off_simp = false);
+    lbool   solveLimited(const vec<Lit>& assumps, bool do_simp = true, bool turn_off_simp = false);
+    bool    solve       (                     bool do_simp = true, bool turn_off_simp = false);
+    bool    solve       (Lit p       ,        bool do_simp = true, bool turn_off_simp = false);
+    bool    solve       (Lit p, Lit q,        bool do_simp = true, bool turn_off_simp = false);
+    bool    solve       (Lit p, Lit q, Lit r, bool do_simp = true, bool turn_off_simp = false);
+
+    void    printStats  () const;
+
+    // Mode of operation:
+    //
+    int     threads;           // Number of solver threads (0 means one per hardware thread).
+    int     share_size;        // Share learnt clauses with at most this many literals.
+    int     share_lbd;         // Share learnt clauses with at most this LBD.
+
+    // Statistics:
+    //
+    int      winner;           // Index of the thread that solved the last call (-1 if none).
+    uint64_t exported, imported;
+
+ protected:
+    class Worker;
+    class ClauseRing;
+
+    // Shared state (only valid during 'solveParallel_()'):
+    //
+    vec<Worker*>        workers;
+    vec<ClauseRing*>    rings;           // 'rings[i]' holds the clauses exported by 'workers[i]'.
+    std::atomic<int>    first_done;      // Index of the first worker to finish (-1 if none).
+
+    lbool   solve_         (bool do_simp = true, bool turn_off_simp = false);
+    lbool   solveParallel_ ();
+};
+
+
+//=================================================================================================
+// Implementation of inline methods:
+
+
+inline bool  ParallelSolver::solve        (                     bool do_simp, bool turn_off_simp)  { budgetOff(); assumptions.clear(); return solve_(do_simp, turn_off_simp) == l_True; }
+inline bool  ParallelSolver::solve        (Lit p       ,        bool do_simp, bool turn_off_simp)  { budgetOff(); assumptions.clear(); assumptions.push(p); return solve_(do_simp, turn_off_simp) == l_True; }
+inline bool  ParallelSolver::solve        (Lit p, Lit q,        bool do_simp, bool turn_off_simp)  { budgetOff(); assumptions.clear(); assumptions.push(p); assumptions.push(q); return solve_(do_simp, turn_off_simp) == l_True; }
+inline bool  ParallelSolver::solve        (Lit p, Lit q, Lit r, bool do_simp, bool turn_off_simp)  { budgetOff(); assumptions.clear(); assumptions.push(p); assumptions.push(q); assumptions.push(r); return solve_(do_simp, turn_off_simp) == l_True; }
+inline bool  ParallelSolver::solve        (const vec<Lit>& assumps, bool do_simp, bool turn_off_simp){
+    budgetOff(); assumps.copyTo(assumptions); return solve_(do_simp, turn_off_simp) == l_True; }
+
+inline lbool ParallelSolver::solveLimited (const vec<Lit>& assumps, bool do_simp, bool turn_off_simp){
+    assumps.copyTo(assumptions); return solve_(do_simp, turn_off_simp); }
+
+//=================================================================================================
+}
+
+#endif
@@ -19,6 +19,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include <errno.h>
+#include <string.h>
 #include <zlib.h>
 
 #include "minisat/utils/System.h"
@@ -48,13 +49,19 @@ static void SIGINT_exit(int) {
     _exit(1); }
 
 
+// Files named '*.opb' or '*.opb.gz' are read as pseudo-Boolean problems:
+static bool isOpb(const char* file) {
+    int n = strlen(file);
+    return (n >= 4 && strcmp(file + n - 4, ".opb") == 0) || (n >= 7 && strcmp(file + n - 7, ".opb.gz") == 0); }
+
+
 //=================================================================================================
 // Main:
 
 int main(int argc, char** argv)
 {
     try {
-        setUsageHelp("USAGE: %s [options] <input-file> <result-output-file>\n\n  where input may be either in plain or gzipped DIMACS.\n");
+        setUsageHelp("USAGE: %s [options] <input-file> <result-output-file>\n\n  where input may be either in plain or gzipped DIMACS (or OPB, if named '*.opb').\n");
         setX86FPUPrecision();
         
         // Extra options:
@@ -66,6 +73,10 @@ int main(int argc, char** argv)
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", 0, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", 0, IntRange(0, INT32_MAX));
         BoolOption   strictp("MAIN", "strict", "Validate DIMACS header during parsing.", false);
+        IntOption    parse_threads("MAIN", "parse-threads", "Threads used to read uncompressed input (0 = one per hardware thread).", 1, IntRange(0, INT32_MAX));
+        StringOption proof  ("MAIN", "proof",  "If given, write a proof of unsatisfiability to this file.");
+        BoolOption   proof_bin("MAIN", "proof-binary", "Write the proof in binary format.", true);
+        BoolOption   lrat   ("MAIN", "lrat",   "Write an LRAT proof (with clause numbers and hints) instead of DRAT.", false);
 
         parseOptions(argc, argv, true);
         
@@ -88,17 +99,26 @@ int main(int argc, char** argv)
         if (argc == 1)
             printf("Reading from standard input... Use '--help' for help.\n");
 
-        gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
-        if (in == NULL)
-            printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
-        
         if (S.verbosity > 0){
             printf("============================[ Problem Statistics ]=============================\n");
             printf("|                                                                             |\n"); }
         
-        parse_DIMACS(in, S, (bool)strictp);
-        gzclose(in);
+        if (proof && !S.openProof((const char*)proof, (bool)proof_bin, (bool)lrat))
+            printf("ERROR! Could not open proof file: %s\n", (const char*)proof), exit(1);
+
+        // The objective of a pseudo-Boolean problem is minimized after simplification, so its
+        // variables must not be eliminated:
+        bool         opb = argc > 1 && isOpb(argv[1]);
+        vec<Lit>     obj_lits;
+        vec<int64_t> obj_coefs;
+        if (opb && dimacs)
+            printf("ERROR! Pseudo-Boolean problems can not be written in DIMACS\n"), exit(1);
+        if (opb ? !parse_OPB(argv[1], S, obj_lits, obj_coefs) : !parse_DIMACS(argc == 1 ? NULL : argv[1], S, (bool)strictp, parse_threads))
+            printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
+        for (int i = 0; i < obj_lits.size(); i++)
+            S.setFrozen(var(obj_lits[i]), true);
         FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
+        int   n_vars = S.nVars();  // Variables added by simplification are not part of the model.
 
         if (S.verbosity > 0){
             printf("|  Number of variables:  %12d                                         |\n", S.nVars());
@@ -112,7 +132,8 @@ int main(int argc, char** argv)
         // voluntarily:
         sigTerm(SIGINT_interrupt);
 
-        S.eliminate(true);
+        // Keep the simplification state if it is needed for inprocessing:
+        S.eliminate(S.inprocess_first == 0);
         double simplified_time = cpuTime();
         if (S.verbosity > 0){
             printf("|  Simplification time:  %12.2f s                                       |\n", simplified_time - parsed_time);
@@ -126,14 +147,39 @@ int main(int argc, char** argv)
                 S.printStats();
                 printf("\n"); }
             printf("UNSATISFIABLE\n");
+            S.closeProof();
             exit(20);
         }
 
-        lbool ret = l_Undef;
+        lbool ret     = l_Undef;
+        bool  optimum = false;
 
         if (solve){
             vec<Lit> dummy;
             ret = S.solveLimited(dummy);
+
+            // Minimize the objective by linear search: each model must cost less than the last one.
+            vec<lbool>   best;
+            vec<int64_t> cs;
+            while (ret == l_True && obj_lits.size() > 0){
+                int64_t cost = 0;
+                for (int i = 0; i < obj_lits.size(); i++)
+                    if (S.modelValue(obj_lits[i]) == l_True)
+                        cost += obj_coefs[i];
+                printf("o %" PRId64 "\n", cost);
+                fflush(stdout);
+                S.model.copyTo(best);
+
+                cs.clear();
+                for (int i = 0; i < obj_coefs.size(); i++)
+                    cs.push(-obj_coefs[i]);
+                ret = S.addLinear(obj_lits, cs, 1 - cost) ? S.solveLimited(dummy) : l_False;
+                if (ret != l_True){
+                    optimum = ret == l_False;
+                    ret     = l_True;
+                    best.moveTo(S.model);
+                    break; }
+            }
         }else if (S.verbosity > 0)
             printf("===============================================================================\n");
 
@@ -143,11 +189,11 @@ int main(int argc, char** argv)
         if (S.verbosity > 0){
             S.printStats();
             printf("\n"); }
-        printf(ret == l_True ? "SATISFIABLE\n" : ret == l_False ? "UNSATISFIABLE\n" : "INDETERMINATE\n");
+        printf(optimum ? "OPTIMUM FOUND\n" : ret == l_True ? "SATISFIABLE\n" : ret == l_False ? "UNSATISFIABLE\n" : "INDETERMINATE\n");
         if (res != NULL){
             if (ret == l_True){
                 fprintf(res, "SAT\n");
-                for (int i = 0; i < S.nVars(); i++)
+                for (int i = 0; i < n_vars; i++)
                     if (S.model[i] != l_Undef)
                         fprintf(res, "%s%s%d", (i==0)?"":" ", (S.model[i]==l_True)?"":"-", i+1);
                 fprintf(res, " 0\n");
@@ -157,6 +203,7 @@ int main(int argc, char** argv)
                 fprintf(res, "INDET\n");
             fclose(res);
         }
+        S.closeProof();
 
 #ifdef NDEBUG
         exit(ret == l_True ? 10 : ret == l_False ? 20 : 0);     // (faster than "return", which will invoke the destructor for 'Solver')
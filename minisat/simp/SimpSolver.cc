@@ -18,6 +18,8 @@ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
 OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 **************************************************************************************************/
 
+#include <thread>
+
 #include "minisat/mtl/Sort.h"
 #include "minisat/simp/SimpSolver.h"
 #include "minisat/utils/System.h"
@@ -33,10 +35,17 @@ static const char* _cat = "SIMP";
 static BoolOption   opt_use_asymm        (_cat, "asymm",        "Shrink clauses by asymmetric branching.", false);
 static BoolOption   opt_use_rcheck       (_cat, "rcheck",       "Check if a clause is already implied. (costly)", false);
 static BoolOption   opt_use_elim         (_cat, "elim",         "Perform variable elimination.", true);
+static BoolOption   opt_use_equiv        (_cat, "equiv",        "Substitute equivalent literals found in the binary clauses.", false);
+static BoolOption   opt_use_gates        (_cat, "gates",        "Only produce the necessary resolvents when eliminating variables defined by gates.", true);
+static BoolOption   opt_use_bce          (_cat, "bce",          "Eliminate blocked clauses.", false);
+static BoolOption   opt_use_cce          (_cat, "cce",          "Eliminate covered clauses (implies 'bce').", false);
+static BoolOption   opt_use_bva          (_cat, "bva",          "Add variables that replace a product of clauses by a sum (bounded variable addition).", false);
+static BoolOption   opt_use_gauss        (_cat, "gauss",        "Detect XOR constraints in the clauses and propagate them by Gauss-Jordan elimination.", false);
 static IntOption    opt_grow             (_cat, "grow",         "Allow a variable elimination step to grow by a number of clauses.", 0);
 static IntOption    opt_clause_lim       (_cat, "cl-lim",       "Variables are not eliminated if it produces a resolvent with a length above this limit. -1 means no limit", 20,   IntRange(-1, INT32_MAX));
 static IntOption    opt_subsumption_lim  (_cat, "sub-lim",      "Do not check if subsumption against a clause larger than this. -1 means no limit.", 1000, IntRange(-1, INT32_MAX));
 static DoubleOption opt_simp_garbage_frac(_cat, "simp-gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered during simplification.",  0.5, DoubleRange(0, false, HUGE_VAL, false));
+static IntOption    opt_elim_threads     (_cat, "elim-threads", "Threads used for variable elimination (0 = one per hardware thread).", 1, IntRange(0, INT32_MAX));
 
 
 //=================================================================================================
@@ -48,19 +57,34 @@ SimpSolver::SimpSolver() :
   , clause_lim         (opt_clause_lim)
   , subsumption_lim    (opt_subsumption_lim)
   , simp_garbage_frac  (opt_simp_garbage_frac)
+  , elim_threads       (opt_elim_threads)
   , use_asymm          (opt_use_asymm)
   , use_rcheck         (opt_use_rcheck)
   , use_elim           (opt_use_elim)
+  , use_equiv          (opt_use_equiv)
+  , use_gates          (opt_use_gates)
+  , use_bce            (opt_use_bce)
+  , use_cce            (opt_use_cce)
+  , use_bva            (opt_use_bva)
+  , use_gauss          (opt_use_gauss)
   , extend_model       (true)
   , merges             (0)
   , asymm_lits         (0)
   , eliminated_vars    (0)
+  , promoted_learnts   (0)
+  , substituted_vars   (0)
+  , gate_vars          (0)
+  , bva_vars           (0)
+  , blocked_clauses    (0)
+  , xor_constraints    (0)
   , elimorder          (1)
   , use_simplification (true)
   , occurs             (ClauseDeleted(ca))
   , elim_heap          (ElimLt(n_occ))
   , bwdsub_assigns     (0)
   , n_touched          (0)
+  , simp_ticks         (0)
+  , simp_ticks_lim     (UINT64_MAX)
 {
     vec<Lit> dummy(1,lit_Undef);
     ca.extra_clause_field = true; // NOTE: must happen before allocating the dummy clause below.
@@ -71,6 +95,8 @@ SimpSolver::SimpSolver() :
 
 SimpSolver::~SimpSolver()
 {
+    for (int i = 0; i < elim_jobs.size(); i++)
+        delete elim_jobs[i];
 }
 
 
@@ -90,6 +116,25 @@ Var SimpSolver::newVar(lbool upol, bool dvar) {
     return v; }
 
 
+void SimpSolver::reserve(int n_vars, int n_clauses, uint64_t n_lits)
+{
+    Solver::reserve(n_vars, n_clauses, n_lits);
+    if (n_vars > reserve_vars_max) n_vars = reserve_vars_max;
+    try {
+        if (n_vars > 0){
+            Var v = n_vars - 1;
+            frozen    .capacity(v);
+            eliminated.capacity(v);
+            if (use_simplification){
+                n_occ  .capacity(mkLit(v, true));
+                occurs .capacity(v);
+                touched.capacity(v);
+            }
+        }
+    } catch (OutOfMemoryException&){}
+}
+
+
 void SimpSolver::releaseVar(Lit l)
 {
     assert(!isEliminated(var(l)));
@@ -154,8 +199,9 @@ bool SimpSolver::addClause_(vec<Lit>& ps)
 
     int nclauses = clauses.size();
 
-    if (use_rcheck && implied(ps))
-        return true;
+    if (use_rcheck && implied(ps)){
+        takeAddId();
+        return true; }
 
     if (!Solver::addClause_(ps))
         return false;
@@ -185,7 +231,7 @@ bool SimpSolver::addClause_(vec<Lit>& ps)
 }
 
 
-void SimpSolver::removeClause(CRef cr)
+void SimpSolver::removeClause(CRef cr, bool proof_del)
 {
     const Clause& c = ca[cr];
 
@@ -196,7 +242,7 @@ void SimpSolver::removeClause(CRef cr)
             occurs.smudge(var(c[i]));
         }
 
-    Solver::removeClause(cr);
+    Solver::removeClause(cr, proof_del);
 }
 
 
@@ -210,26 +256,57 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l)
     // if (!find(subsumption_queue, &c))
     subsumption_queue.insert(cr);
 
+    // Log the strengthened clause before the original is deleted:
+    uint64_t id = 0;
+    if (proof != NULL){
+        add_tmp.clear();
+        for (int i = 0; i < c.size(); i++)
+            if (c[i] != l)
+                add_tmp.push(c[i]);
+        id = proofAdd(add_tmp, proof_hints); }
+
     if (c.size() == 2){
         removeClause(cr);
         c.strengthen(l);
     }else{
         detachClause(cr, true);
+        if (proof != NULL) proofDelete(c);
         c.strengthen(l);
+        if (c.has_id()) c.id(id);
         attachClause(cr);
         remove(occurs[var(l)], cr);
         n_occ[l]--;
         updateElimHeap(var(l));
     }
 
-    return c.size() == 1 ? enqueue(c[0]) && propagate() == CRef_Undef : true;
+    if (c.size() != 1)
+        return true;
+
+    if (value(c[0]) == l_Undef)
+        unit_id[var(c[0])] = id;
+    else if (value(c[0]) == l_False && proof != NULL){
+        proofUnits();
+        proof_hints.clear();
+        if (lrat()){
+            proof_hints.push(unit_id[var(c[0])]);
+            proof_hints.push(id); }
+        vec<Lit> empty;
+        proofAdd(empty, proof_hints);
+    }
+    if (!enqueue(c[0]))
+        return false;
+
+    CRef confl = propagate();
+    if (confl != CRef_Undef){
+        proofEmpty(confl);
+        return false; }
+    return true;
 }
 
 
 // Returns FALSE if clause is always satisfied ('out_clause' should not be used).
 bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause)
 {
-    merges++;
     out_clause.clear();
 
     bool  ps_smallest = _ps.size() < _qs.size();
@@ -261,7 +338,6 @@ bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& ou
 // Returns FALSE if clause is always satisfied.
 bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, int& size)
 {
-    merges++;
 
     bool  ps_smallest = _ps.size() < _qs.size();
     const Clause& ps  =  ps_smallest ? _qs : _ps;
@@ -353,6 +429,10 @@ bool SimpSolver::backwardSubsumptionCheck(bool verbose)
             bwdsub_assigns = trail.size();
             break; }
 
+        // Leave the rest to the next inprocessing round when out of ticks:
+        if (simp_ticks > simp_ticks_lim)
+            break;
+
         // Check top-level assignments by creating a dummy clause and placing it in the queue:
         if (subsumption_queue.size() == 0 && bwdsub_assigns < trail.size()){
             Lit l = trail[bwdsub_assigns++];
@@ -379,6 +459,7 @@ bool SimpSolver::backwardSubsumptionCheck(bool verbose)
         // Search all candidates:
         vec<CRef>& _cs = occurs.lookup(best);
         CRef*       cs = (CRef*)_cs;
+        simp_ticks += _cs.size();
 
         for (int j = 0; j < _cs.size(); j++)
             if (c.mark())
@@ -391,6 +472,13 @@ bool SimpSolver::backwardSubsumptionCheck(bool verbose)
                 else if (l != lit_Error){
                     deleted_literals++;
 
+                    if (lrat()){
+                        // 'c' implies '~l' after which the candidate is falsified:
+                        proofUnits();
+                        proof_hints.clear();
+                        proof_hints.push(cr == bwdsub_tmpunit ? unit_id[var(c[0])] : c.id());
+                        proof_hints.push(ca[cs[j]].id()); }
+
                     if (!strengthenClause(cs[j], ~l))
                         return false;
 
@@ -420,7 +508,11 @@ bool SimpSolver::asymm(Var v, CRef cr)
         else
             l = c[i];
 
-    if (propagate() != CRef_Undef){
+    CRef confl = propagate();
+    if (confl != CRef_Undef){
+        if (proof != NULL){
+            vec<Lit> none;  // (the literals of the strengthened clause are decisions here)
+            proofChain(confl, none, proof_hints); }
         cancelUntil(0);
         asymm_lits++;
         if (!strengthenClause(cr, l))
@@ -456,6 +548,26 @@ static void mkElimClause(vec<uint32_t>& elimclauses, Lit x)
 }
 
 
+// A binary clause whose first literal 'x' is set by 'extendModel()':
+static void mkElimClause(vec<uint32_t>& elimclauses, Lit x, Lit y)
+{
+    elimclauses.push(toInt(x));
+    elimclauses.push(toInt(y));
+    elimclauses.push(2);
+}
+
+
+// The first 'n' literals of 'ps', among which 'x', which comes first and is set by 'extendModel()':
+static void mkElimClause(vec<uint32_t>& elimclauses, Lit x, const vec<Lit>& ps, int n)
+{
+    elimclauses.push(toInt(x));
+    for (int i = 0; i < n; i++)
+        if (ps[i] != x)
+            elimclauses.push(toInt(ps[i]));
+    elimclauses.push(n);
+}
+
+
 static void mkElimClause(vec<uint32_t>& elimclauses, Var v, Clause& c)
 {
     int first = elimclauses.size();
@@ -482,18 +594,258 @@ static void mkElimClause(vec<uint32_t>& elimclauses, Var v, Clause& c)
 
 
 
-bool SimpSolver::eliminateVar(Var v)
+//=================================================================================================
+// Gate detection:
+
+
+// Returns a clause of 'cs' consisting of exactly the literals 'lits', or 'CRef_Undef':
+CRef SimpSolver::findClause(const vec<CRef>& cs, const vec<Lit>& lits, uint64_t& ticks)
 {
-    assert(!frozen[v]);
-    assert(!isEliminated(v));
-    assert(value(v) == l_Undef);
+    for (int i = 0; i < lits.size(); i++)
+        seen[var(lits[i])] = 1 + sign(lits[i]);
+
+    CRef found = CRef_Undef;
+    ticks += cs.size();
+    for (int i = 0; i < cs.size() && found == CRef_Undef; i++){
+        const Clause& c = ca[cs[i]];
+        if (c.size() != lits.size()) continue;
+        int j;
+        for (j = 0; j < c.size() && seen[var(c[j])] == 1 + sign(c[j]); j++);
+        if (j == c.size())
+            found = cs[i];
+    }
 
-    // Split the occurrences into positive and negative:
-    //
+    for (int i = 0; i < lits.size(); i++)
+        seen[var(lits[i])] = 0;
+    return found;
+}
+
+
+// 'l' is the AND of the literals 'a_i' if there are binary clauses '(~l | a_i)' and a clause
+// '(l | ~a_1 | ... | ~a_k)'. The clauses 'ls' contain 'l' and the clauses 'nls' contain '~l':
+bool SimpSolver::andGate(Lit l, const vec<CRef>& ls, const vec<CRef>& nls, vec<CRef>& gate_l, vec<CRef>& gate_nl, uint64_t& ticks)
+{
+    vec<Var> marked;
+    for (int i = 0; i < nls.size(); i++){
+        const Clause& c = ca[nls[i]];
+        if (c.size() != 2) continue;
+        Lit a = c[0] == ~l ? c[1] : c[0];
+        if (seen[var(a)] == 0){
+            seen[var(a)] = 1 + sign(a);
+            marked.push(var(a)); }
+    }
+
+    CRef def = CRef_Undef;
+    if (marked.size() > 0){
+        ticks += ls.size();
+        for (int i = 0; i < ls.size() && def == CRef_Undef; i++){
+            const Clause& c = ca[ls[i]];
+            int j;
+            for (j = 0; j < c.size() && (c[j] == l || seen[var(c[j])] == 1 + sign(~c[j])); j++);
+            if (j == c.size())
+                def = ls[i];
+        }
+    }
+    for (int i = 0; i < marked.size(); i++)
+        seen[marked[i]] = 0;
+
+    if (def == CRef_Undef)
+        return false;
+
+    // Collect one binary clause for each input of the gate:
+    const Clause& d = ca[def];
+    for (int i = 0; i < d.size(); i++)
+        if (d[i] != l)
+            seen[var(d[i])] = 1 + sign(~d[i]);
+    gate_l.push(def);
+    for (int i = 0; i < nls.size(); i++){
+        const Clause& c = ca[nls[i]];
+        if (c.size() != 2) continue;
+        Lit a = c[0] == ~l ? c[1] : c[0];
+        if (seen[var(a)] == 1 + sign(a)){
+            seen[var(a)] = 0;
+            gate_nl.push(nls[i]); }
+    }
+    for (int i = 0; i < d.size(); i++)
+        seen[var(d[i])] = 0;
+
+    return true;
+}
+
+
+// 'l' is the if-then-else 'c ? t : e' if there are clauses '(~l | ~c | t)', '(~l | c | e)',
+// '(l | ~c | ~t)' and '(l | c | ~e)'. The clauses 'ls' contain 'l' and the clauses 'nls' contain '~l':
+bool SimpSolver::iteGate(Lit l, const vec<CRef>& ls, const vec<CRef>& nls, vec<CRef>& gate_l, vec<CRef>& gate_nl, uint64_t& ticks)
+{
+    vec<Lit> lits;
+    for (int i = 0; i < nls.size(); i++){
+        const Clause& x = ca[nls[i]];
+        if (x.size() != 3) continue;
+
+        for (int j = i + 1; j < nls.size(); j++){
+            const Clause& y = ca[nls[j]];
+            if (y.size() != 3) continue;
+            ticks++;
+
+            for (int a = 0; a < 3; a++)
+                for (int b = 0; b < 3; b++){
+                    if (x[a] == ~l || x[a] != ~y[b]) continue;
+
+                    // The condition is '~x[a]', and the remaining literals are 't' and 'e':
+                    Lit c = ~x[a], t = lit_Undef, e = lit_Undef;
+                    for (int k = 0; k < 3; k++){
+                        if (x[k] != ~l && x[k] != ~c) t = x[k];
+                        if (y[k] != ~l && y[k] !=  c) e = y[k]; }
+
+                    lits.clear(); lits.push(l); lits.push(~c); lits.push(~t);
+                    CRef ct = findClause(ls, lits, ticks);
+                    if (ct == CRef_Undef) continue;
+                    lits.clear(); lits.push(l); lits.push(c); lits.push(~e);
+                    CRef ce = findClause(ls, lits, ticks);
+                    if (ce == CRef_Undef) continue;
+
+                    gate_l .push(ct);
+                    gate_l .push(ce);
+                    gate_nl.push(nls[i]);
+                    gate_nl.push(nls[j]);
+                    return true;
+                }
+        }
+    }
+
+    return false;
+}
+
+
+// 'v' is the XOR of the other variables of a clause if the clauses over the same variables with all
+// combinations of signs of the same parity are present. Only clauses of up to 5 literals are tried,
+// each needing 16 clauses to define 'v':
+bool SimpSolver::xorGate(Var v, const vec<CRef>& pos, const vec<CRef>& neg, vec<CRef>& gate_pos, vec<CRef>& gate_neg, uint64_t& ticks)
+{
+    vec<Lit> lits;
+    for (int i = 0; i < pos.size(); i++){
+        const Clause& c    = ca[pos[i]];
+        int           size = c.size();
+        if (size < 3 || size > 5 || pos.size() < (1 << (size - 2)) || neg.size() < (1 << (size - 2)))
+            continue;
+
+        bool found = true;
+        for (uint32_t m = 0; m < (1u << size) && found; m++){
+            int flips = 0;
+            for (int j = 0; j < size; j++)
+                flips += (m >> j) & 1;
+            if (flips % 2 != 0) continue;
+
+            lits.clear();
+            bool has_pos = true;
+            for (int j = 0; j < size; j++){
+                Lit p = c[j] ^ (bool)((m >> j) & 1);
+                lits.push(p);
+                if (var(p) == v) has_pos = !sign(p); }
+
+            CRef d = findClause(has_pos ? pos : neg, lits, ticks);
+            if (d == CRef_Undef)
+                found = false;
+            else
+                (has_pos ? gate_pos : gate_neg).push(d);
+        }
+        if (found)
+            return true;
+
+        gate_pos.clear();
+        gate_neg.clear();
+    }
+
+    return false;
+}
+
+
+// Move the clauses 'gate' to the front of 'cs', and return their number:
+static int gateToFront(vec<CRef>& cs, const vec<CRef>& gate)
+{
+    int n = 0;
+    for (int i = 0; i < gate.size(); i++)
+        for (int j = n; j < cs.size(); j++)
+            if (cs[j] == gate[i]){
+                CRef tmp = cs[n];
+                cs[n++]  = cs[j];
+                cs[j]    = tmp;
+                break; }
+    return n;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  findGate : (job : ElimJob&)  ->  [void]
+|  
+|  Description:
+|    Look for clauses defining the variable of 'job' as an AND, ITE or XOR gate of other variables
+|    among its positive and negative occurrences. The clauses of a gate are moved to the front, and
+|    their numbers are stored in 'pos_g' and 'neg_g' (both zero if no gate was found).
+|________________________________________________________________________________________________@*/
+void SimpSolver::findGate(ElimJob& job)
+{
+    Var       v = job.v;
+    vec<CRef> gate_pos, gate_neg;
+    if (   andGate( mkLit(v), job.pos, job.neg, gate_pos, gate_neg, job.ticks)
+        || andGate(~mkLit(v), job.neg, job.pos, gate_neg, gate_pos, job.ticks)
+        || iteGate( mkLit(v), job.pos, job.neg, gate_pos, gate_neg, job.ticks)
+        || xorGate(v, job.pos, job.neg, gate_pos, gate_neg, job.ticks)){
+        job.pos_g = gateToFront(job.pos, gate_pos);
+        job.neg_g = gateToFront(job.neg, gate_neg);
+    }else
+        job.pos_g = job.neg_g = 0;
+}
+
+
+//=================================================================================================
+// Variable elimination:
+
+
+// Split the occurrences of 'v' into positive and negative:
+void SimpSolver::elimOccurs(Var v, ElimJob& job)
+{
     const vec<CRef>& cls = occurs.lookup(v);
-    vec<CRef>        pos, neg;
-    for (int i = 0; i < cls.size(); i++)
-        (find(ca[cls[i]], mkLit(v)) ? pos : neg).push(cls[i]);
+    job.v      = v;
+    job.elim   = false;
+    job.size   = 0;
+    job.ticks  = cls.size();
+    job.merges = 0;
+    job.pos.clear();
+    job.neg.clear();
+    job.resolvents.clear();
+    job.sources.clear();
+    for (int i = 0; i < cls.size(); i++){
+        (find(ca[cls[i]], mkLit(v)) ? job.pos : job.neg).push(cls[i]);
+        job.size += ca[cls[i]].size(); }
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  elimResolve : (job : ElimJob&)  ->  [void]
+|  
+|  Description:
+|    Decide whether the variable of 'job' can be eliminated, and if so, compute its resolvents. Only
+|    the job itself is modified (and 'seen' for the variables of its occurrences), so that jobs with
+|    disjoint occurrences can be computed in parallel.
+|________________________________________________________________________________________________@*/
+void SimpSolver::elimResolve(ElimJob& job)
+{
+    const vec<CRef>& pos = job.pos;
+    const vec<CRef>& neg = job.neg;
+    Var              v   = job.v;
+    job.ticks += (uint64_t)pos.size() * neg.size();
+
+    // If 'v' is defined by a gate, the resolvents of two gate clauses are tautologies and those of two
+    // other clauses are implied by the rest. Only resolvents of a gate clause with another clause are
+    // needed then:
+    //
+    job.pos_g = job.neg_g = 0;
+    if (use_gates)
+        findGate(job);
+    bool gate = job.pos_g > 0;
 
     // Check wether the increase in number of clauses stays within the allowed ('grow'). Moreover, no
     // clause must exceed the limit on the maximal clause size (if it is set):
@@ -502,15 +854,46 @@ bool SimpSolver::eliminateVar(Var v)
     int clause_size = 0;
 
     for (int i = 0; i < pos.size(); i++)
-        for (int j = 0; j < neg.size(); j++)
+        for (int j = 0; j < neg.size(); j++){
+            if (gate && (i < job.pos_g) == (j < job.neg_g)) continue;
+            job.merges++;
             if (merge(ca[pos[i]], ca[neg[j]], v, clause_size) && 
-                (++cnt > cls.size() + grow || (clause_lim != -1 && clause_size > clause_lim)))
-                return true;
+                (++cnt > pos.size() + neg.size() + grow || (clause_lim != -1 && clause_size > clause_lim)))
+                return;
+        }
+
+    // Produce clauses in cross product:
+    vec<Lit> resolvent;
+    for (int i = 0; i < pos.size(); i++)
+        for (int j = 0; j < neg.size(); j++){
+            if (gate && (i < job.pos_g) == (j < job.neg_g)) continue;
+            job.merges++;
+            if (merge(ca[pos[i]], ca[neg[j]], v, resolvent)){
+                for (int k = 0; k < resolvent.size(); k++)
+                    job.resolvents.push(resolvent[k]);
+                job.resolvents.push(lit_Undef);
+                job.sources.push(i);
+                job.sources.push(j);
+            }
+        }
+    job.elim = true;
+}
+
+
+// Eliminate the variable of 'job' by replacing its occurrences with the resolvents computed by
+// 'elimResolve()'. Returns FALSE if a conflict was found.
+bool SimpSolver::elimApply(ElimJob& job)
+{
+    const vec<CRef>& pos = job.pos;
+    const vec<CRef>& neg = job.neg;
+    Var              v   = job.v;
+    assert(job.elim);
 
     // Delete and store old clauses:
     eliminated[v] = true;
     setDecisionVar(v, false);
     eliminated_vars++;
+    if (job.pos_g > 0) gate_vars++;
 
     if (pos.size() > neg.size()){
         for (int i = 0; i < neg.size(); i++)
@@ -522,15 +905,31 @@ bool SimpSolver::eliminateVar(Var v)
         mkElimClause(elimclauses, ~mkLit(v));
     }
 
-    for (int i = 0; i < cls.size(); i++)
-        removeClause(cls[i]); 
+    // NOTE: a proof must not lose the clauses before the resolvents are logged, so the deletions
+    // are logged afterwards (the removed clauses stay readable until the next garbage collection).
+    for (int i = 0; i < pos.size(); i++) removeClause(pos[i], false);
+    for (int i = 0; i < neg.size(); i++) removeClause(neg[i], false);
 
-    // Produce clauses in cross product:
+    // Add the resolvents:
     vec<Lit>& resolvent = add_tmp;
-    for (int i = 0; i < pos.size(); i++)
-        for (int j = 0; j < neg.size(); j++)
-            if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) && !addClause_(resolvent))
-                return false;
+    for (int i = 0, k = 0; i < job.sources.size(); i += 2, k++){
+        resolvent.clear();
+        for (; job.resolvents[k] != lit_Undef; k++)
+            resolvent.push(job.resolvents[k]);
+        if (proof != NULL){
+            proofUnits();
+            proof_hints.clear();
+            if (lrat()){
+                proof_hints.push(ca[pos[job.sources[i]]].id());
+                proof_hints.push(ca[neg[job.sources[i+1]]].id()); }
+            add_id = proofAdd(resolvent, proof_hints); }
+        if (!addClause_(resolvent))
+            return false;
+    }
+
+    if (proof != NULL){
+        for (int i = 0; i < pos.size(); i++) proofDelete(ca[pos[i]]);
+        for (int i = 0; i < neg.size(); i++) proofDelete(ca[neg[i]]); }
 
     // Free occurs list for this variable:
     occurs[v].clear(true);
@@ -538,12 +937,163 @@ bool SimpSolver::eliminateVar(Var v)
     // Free watchers lists for this variable, if possible:
     if (watches[ mkLit(v)].size() == 0) watches[ mkLit(v)].clear(true);
     if (watches[~mkLit(v)].size() == 0) watches[~mkLit(v)].clear(true);
+    if (watches_bin[ mkLit(v)].size() == 0) watches_bin[ mkLit(v)].clear(true);
+    if (watches_bin[~mkLit(v)].size() == 0) watches_bin[~mkLit(v)].clear(true);
 
     return backwardSubsumptionCheck();
 }
 
 
-bool SimpSolver::substitute(Var v, Lit x)
+bool SimpSolver::eliminateVar(Var v)
+{
+    assert(!frozen[v]);
+    assert(!isEliminated(v));
+    assert(value(v) == l_Undef);
+
+    ElimJob job;
+    elimOccurs(v, job);
+    elimResolve(job);
+    simp_ticks += job.ticks;
+    merges     += job.merges;
+
+    return !job.elim || elimApply(job);
+}
+
+
+void SimpSolver::elimResolveJobs(int n_jobs, int first, int step)
+{
+    for (int i = first; i < n_jobs; i += step)
+        elimResolve(*elim_jobs[i]);
+}
+
+
+// Returns TRUE if the occurrences of the variable of 'job' were changed after 'elimOccurs()':
+bool SimpSolver::elimChanged(const ElimJob& job)
+{
+    const vec<CRef>& cls = occurs.lookup(job.v);
+    if (cls.size() != job.pos.size() + job.neg.size())
+        return true;
+
+    int size = 0;
+    for (int i = 0; i < cls.size(); i++){
+        const Clause& c = ca[cls[i]];
+        for (int j = 0; j < c.size(); j++)
+            if (value(c[j]) != l_Undef)
+                return true;
+        size += c.size(); }
+    return size != job.size;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  eliminateBatches : (n_threads : int)  ->  [bool]
+|  
+|  Description:
+|    Empty 'elim_heap' like the sequential loop of 'eliminateTouched()', but in batches of variables
+|    whose occurrences have no variables in common. The resolvents of a batch are computed by
+|    'n_threads' threads, after which they are applied in the order of the batch. Applying one job
+|    cannot add occurrences of the variables of the others, but may assign or remove some through
+|    unit propagation: such jobs are computed again. The result does not depend on the number of
+|    threads. Returns FALSE if a conflict was found.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::eliminateBatches(int n_threads)
+{
+    vec<Var>          batch, deferred, claimed_vars;
+    vec<char>         claimed(nVars(), 0);
+    vec<std::thread*> threads;
+    while (elim_jobs.size() < elim_batch)
+        elim_jobs.push(new ElimJob());
+
+    while (!elim_heap.empty() && simp_ticks <= simp_ticks_lim && !asynch_interrupt){
+
+        // Select variables with disjoint occurrences, in the order of the heap:
+        batch.clear();
+        deferred.clear();
+        while (batch.size() < elim_batch && deferred.size() < elim_batch && !elim_heap.empty()){
+            Var elim = elim_heap.removeMin();
+            if (isEliminated(elim) || value(elim) != l_Undef) continue;
+
+            if (use_asymm){
+                // Temporarily freeze variable. Otherwise, it would immediately end up on the queue again:
+                bool was_frozen = frozen[elim];
+                frozen[elim] = true;
+                if (!asymmVar(elim))
+                    return false;
+                frozen[elim] = was_frozen; }
+
+            if (value(elim) != l_Undef || frozen[elim]) continue;
+
+            const vec<CRef>& cls  = occurs.lookup(elim);
+            bool             free = true;
+            simp_ticks += cls.size();
+            for (int i = 0; i < cls.size() && free; i++){
+                const Clause& c = ca[cls[i]];
+                for (int j = 0; j < c.size() && free; j++)
+                    free = !claimed[var(c[j])];
+            }
+            if (!free){
+                deferred.push(elim);
+                continue; }
+
+            for (int i = 0; i < cls.size(); i++){
+                const Clause& c = ca[cls[i]];
+                for (int j = 0; j < c.size(); j++)
+                    if (!claimed[var(c[j])]){
+                        claimed[var(c[j])] = 1;
+                        claimed_vars.push(var(c[j])); }
+            }
+            batch.push(elim);
+        }
+
+        for (int i = 0; i < claimed_vars.size(); i++)
+            claimed[claimed_vars[i]] = 0;
+        claimed_vars.clear();
+        for (int i = 0; i < deferred.size(); i++)
+            if (!elim_heap.inHeap(deferred[i]))
+                elim_heap.insert(deferred[i]);
+
+        // Compute the resolvents:
+        for (int i = 0; i < batch.size(); i++)
+            elimOccurs(batch[i], *elim_jobs[i]);
+        int n = n_threads < batch.size() ? n_threads : batch.size();
+        for (int t = 1; t < n; t++)
+            threads.push(new std::thread(&SimpSolver::elimResolveJobs, this, batch.size(), t, n));
+        elimResolveJobs(batch.size(), 0, n);
+        for (int t = 0; t < threads.size(); t++){
+            threads[t]->join();
+            delete threads[t]; }
+        threads.clear();
+
+        if (verbosity >= 2)
+            printf("elimination left: %10d\r", elim_heap.size());
+
+        // Apply them in order:
+        for (int i = 0; i < batch.size(); i++){
+            ElimJob& job = *elim_jobs[i];
+            simp_ticks += job.ticks;
+            merges     += job.merges;
+            if (value(job.v) != l_Undef)
+                continue;
+            else if (elimChanged(job)){
+                if (!eliminateVar(job.v))
+                    return false;
+            }else if (job.elim && !elimApply(job))
+                return false;
+        }
+
+        checkGarbage(simp_garbage_frac);
+    }
+
+    return true;
+}
+
+
+// The proof numbers 'pos_id' and 'neg_id', if known, are those of the clauses '(~v | x)' and '(v | ~x)',
+// which must be part of the proof already. Otherwise, LRAT hints are left to the checker. Clauses
+// that become units are only collected (see 'addSubstUnits()'), since propagating them could assign
+// variables that other substitutions still depend on.
+bool SimpSolver::substitute(Var v, Lit x, uint64_t pos_id, uint64_t neg_id)
 {
     assert(!frozen[v]);
     assert(!isEliminated(v));
@@ -553,24 +1103,96 @@ bool SimpSolver::substitute(Var v, Lit x)
 
     eliminated[v] = true;
     setDecisionVar(v, false);
+    mkElimClause(elimclauses,  mkLit(v), ~x);
+    mkElimClause(elimclauses, ~mkLit(v),  x);
     const vec<CRef>& cls = occurs.lookup(v);
     
     vec<Lit>& subst_clause = add_tmp;
     for (int i = 0; i < cls.size(); i++){
         Clause& c = ca[cls[i]];
+        if (satisfied(c)){
+            removeClause(cls[i]);
+            continue; }
 
+        uint64_t hint = 0;
         subst_clause.clear();
         for (int j = 0; j < c.size(); j++){
             Lit p = c[j];
-            subst_clause.push(var(p) == v ? x ^ sign(p) : p);
+            if (var(p) == v){
+                hint = sign(p) ? neg_id : pos_id;
+                p    = x ^ sign(p); }
+            subst_clause.push(p);
         }
 
+        // The clause may already contain 'x' or '~x':
+        sort(subst_clause);
+        bool taut = false;
+        int  j, k;
+        for (j = k = 0; j < subst_clause.size(); j++)
+            if (k > 0 && subst_clause[j] == ~subst_clause[k-1])
+                taut = true;
+            else if (k == 0 || subst_clause[j] != subst_clause[k-1])
+                subst_clause[k++] = subst_clause[j];
+        subst_clause.shrink(j - k);
+
+        if (taut){
+            removeClause(cls[i]);
+            continue; }
+
+        if (proof != NULL){
+            proof_hints.clear();
+            if (lrat() && hint != 0){
+                proof_hints.push(hint);
+                proof_hints.push(c.id()); }
+            add_id = proofAdd(subst_clause, proof_hints); }
+
         removeClause(cls[i]);
 
-        if (!addClause_(subst_clause))
+        int n_free = 0;
+        for (j = 0; j < subst_clause.size(); j++)
+            if (value(subst_clause[j]) != l_False)
+                n_free++;
+        if (n_free == 1){
+            for (j = 0; j < subst_clause.size(); j++)
+                subst_units.push(subst_clause[j]);
+            subst_units.push(lit_Undef);
+            subst_unit_ids.push(takeAddId());
+        }else if (!addClause_(subst_clause))
             return ok = false;
     }
 
+    // Free occurs list and watchers lists for this variable, if possible:
+    occurs[v].clear(true);
+    if (watches[ mkLit(v)].size() == 0) watches[ mkLit(v)].clear(true);
+    if (watches[~mkLit(v)].size() == 0) watches[~mkLit(v)].clear(true);
+    if (watches_bin[ mkLit(v)].size() == 0) watches_bin[ mkLit(v)].clear(true);
+    if (watches_bin[~mkLit(v)].size() == 0) watches_bin[~mkLit(v)].clear(true);
+
+    return true;
+}
+
+
+// Add the unit clauses collected by 'substitute()' and propagate them. Returns FALSE if a conflict
+// was found.
+bool SimpSolver::addSubstUnits()
+{
+    vec<Lit> unit;
+    for (int i = 0, k = 0; i < subst_units.size(); i++)
+        if (subst_units[i] != lit_Undef)
+            unit.push(subst_units[i]);
+        else{
+            add_id = subst_unit_ids[k++];
+            addClause_(unit);
+            unit.clear(); }
+    subst_units.clear();
+    subst_unit_ids.clear();
+
+    if (!ok) return false;
+
+    CRef confl = propagate();
+    if (confl != CRef_Undef){
+        proofEmpty(confl);
+        return ok = false; }
     return true;
 }
 
@@ -592,22 +1214,17 @@ void SimpSolver::extendModel()
 }
 
 
-bool SimpSolver::eliminate(bool turn_off_elim)
+// Subsume and eliminate until all touched clauses and variables are processed, the user interrupts,
+// or 'simp_ticks_lim' is exceeded. Returns FALSE if a conflict was found.
+bool SimpSolver::eliminateTouched()
 {
-    if (!simplify())
-        return false;
-    else if (!use_simplification)
-        return true;
-
-    // Main simplification loop:
-    //
-    while (n_touched > 0 || bwdsub_assigns < trail.size() || elim_heap.size() > 0){
+    while ((n_touched > 0 || bwdsub_assigns < trail.size() || elim_heap.size() > 0) && simp_ticks <= simp_ticks_lim){
 
         gatherTouchedClauses();
         // printf("  ## (time = %6.2f s) BWD-SUB: queue = %d, trail = %d\n", cpuTime(), subsumption_queue.size(), trail.size() - bwdsub_assigns);
         if ((subsumption_queue.size() > 0 || bwdsub_assigns < trail.size()) && 
-            !backwardSubsumptionCheck(true)){
-            ok = false; goto cleanup; }
+            !backwardSubsumptionCheck(true))
+            return false;
 
         // Empty elim_heap and return immediately on user-interrupt:
         if (asynch_interrupt){
@@ -615,10 +1232,15 @@ bool SimpSolver::eliminate(bool turn_off_elim)
             assert(subsumption_queue.size() == 0);
             assert(n_touched == 0);
             elim_heap.clear();
-            goto cleanup; }
+            return true; }
 
         // printf("  ## (time = %6.2f s) ELIM: vars = %d\n", cpuTime(), elim_heap.size());
-        for (int cnt = 0; !elim_heap.empty(); cnt++){
+        int n_threads = elim_threads > 0 ? elim_threads : (int)std::thread::hardware_concurrency();
+        if (use_elim && n_threads > 1){
+            if (!eliminateBatches(n_threads))
+                return false;
+        }else
+        for (int cnt = 0; !elim_heap.empty() && simp_ticks <= simp_ticks_lim; cnt++){
             Var elim = elim_heap.removeMin();
             
             if (asynch_interrupt) break;
@@ -632,21 +1254,44 @@ bool SimpSolver::eliminate(bool turn_off_elim)
                 // Temporarily freeze variable. Otherwise, it would immediately end up on the queue again:
                 bool was_frozen = frozen[elim];
                 frozen[elim] = true;
-                if (!asymmVar(elim)){
-                    ok = false; goto cleanup; }
+                if (!asymmVar(elim))
+                    return false;
                 frozen[elim] = was_frozen; }
 
             // At this point, the variable may have been set by assymetric branching, so check it
             // again. Also, don't eliminate frozen variables:
-            if (use_elim && value(elim) == l_Undef && !frozen[elim] && !eliminateVar(elim)){
-                ok = false; goto cleanup; }
+            if (use_elim && value(elim) == l_Undef && !frozen[elim] && !eliminateVar(elim))
+                return false;
 
             checkGarbage(simp_garbage_frac);
         }
 
-        assert(subsumption_queue.size() == 0);
+        assert(subsumption_queue.size() == 0 || simp_ticks > simp_ticks_lim);
     }
- cleanup:
+
+    return true;
+}
+
+
+bool SimpSolver::eliminate(bool turn_off_elim)
+{
+    if (!simplify())
+        return false;
+    else if (!use_simplification)
+        return true;
+
+    // Main simplification loop:
+    //
+    bool res = !use_equiv || substituteEquivs();
+    if (res && use_gauss && proof == NULL)
+        findXors();
+    if (res && (use_bce || use_cce))
+        eliminateBlocked();
+    res = res && eliminateTouched();
+    if (res && use_bva)
+        res = addVariables() && eliminateTouched();
+    if (!res)
+        ok = false;
 
     // If no more simplification is needed, free all simplification-related data structures:
     if (turn_off_elim){
@@ -672,11 +1317,787 @@ bool SimpSolver::eliminate(bool turn_off_elim)
     if (verbosity >= 1 && elimclauses.size() > 0)
         printf("|  Eliminated clauses:     %10.2f Mb                                      |\n", 
                double(elimclauses.size() * sizeof(uint32_t)) / (1024*1024));
+    if (verbosity >= 1 && substituted_vars > 0)
+        printf("|  Substituted variables:  %10d                                         |\n", substituted_vars);
+    if (verbosity >= 1 && blocked_clauses > 0)
+        printf("|  Blocked clauses:        %10d                                         |\n", blocked_clauses);
+    if (verbosity >= 1 && bva_vars > 0)
+        printf("|  Added variables:        %10d                                         |\n", bva_vars);
+    if (verbosity >= 1 && xor_constraints > 0)
+        printf("|  XOR constraints:        %10d                                         |\n", xor_constraints);
 
     return ok;
 }
 
 
+//=================================================================================================
+// Equivalent literal substitution:
+
+
+/*_________________________________________________________________________________________________
+|
+|  findEquivs : (repr : vec<Lit>&)  ->  [bool]
+|  
+|  Description:
+|    Find the strongly connected components of the binary implication graph with Tarjan's algorithm.
+|    The literals of a component are equivalent. 'repr' maps each literal, indexed by 'toInt()', to
+|    the representative of its component (frozen if possible, otherwise the one of the smallest
+|    variable), such that 'repr[~p] == ~repr[p]'. Assigned and eliminated literals map to 'lit_Undef'.
+|    A component with both 'p' and '~p' makes the clauses unsatisfiable, and FALSE is returned after
+|    deriving the conflict.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::findEquivs(vec<Lit>& repr)
+{
+    assert(decisionLevel() == 0);
+    int                  n = 2 * nVars();
+    vec<uint32_t>        index(n, 0), low(n, 0);
+    vec<Lit>             stack, comp;
+    vec<ShrinkStackElem> frames;    // (the literal being visited and the position in its watchers)
+    uint32_t             counter = 0;
+    Lit                  contra  = lit_Undef;
+    repr.clear();
+    repr.growTo(n, lit_Undef);
+
+    for (int k = 0; k < n && contra == lit_Undef; k++){
+        Lit root = toLit(k);
+        if (index[k] != 0 || value(root) != l_Undef || !decision[var(root)]) continue;
+
+        index[k] = low[k] = ++counter;
+        stack.push(root);
+        frames.push(ShrinkStackElem(0, root));
+        while (frames.size() > 0){
+            Lit                 p  = frames.last().l;
+            const vec<Watcher>& ws = watches_bin[p];
+            if (frames.last().i < (uint32_t)ws.size()){
+                const Watcher& w = ws[frames.last().i++];
+                Lit            q = w.blocker;
+                if (ca[w.cref].mark() == 1 || value(q) != l_Undef || !decision[var(q)])
+                    continue;
+                else if (index[toInt(q)] == 0){
+                    index[toInt(q)] = low[toInt(q)] = ++counter;
+                    stack.push(q);
+                    frames.push(ShrinkStackElem(0, q));
+                }else if (repr[toInt(q)] == lit_Undef && index[toInt(q)] < low[toInt(p)])    // (still on the stack)
+                    low[toInt(p)] = index[toInt(q)];
+                continue;
+            }
+
+            frames.pop();
+            if (frames.size() > 0){
+                Lit parent = frames.last().l;
+                if (low[toInt(p)] < low[toInt(parent)])
+                    low[toInt(parent)] = low[toInt(p)]; }
+            if (low[toInt(p)] != index[toInt(p)])
+                continue;
+
+            comp.clear();
+            Lit q;
+            do {
+                q = stack.last();
+                stack.pop();
+                comp.push(q);
+            } while (q != p);
+
+            // The component of the negated literals, if found already, determines the representative:
+            Lit r = repr[toInt(~p)] != lit_Undef ? ~repr[toInt(~p)] : lit_Undef;
+            if (r == lit_Undef){
+                r = comp[0];
+                for (int i = 0; i < comp.size(); i++){
+                    Var x = var(comp[i]);
+                    if (seen[x]) contra = comp[i];
+                    seen[x] = 1;
+                    if (frozen[x] > frozen[var(r)] || (frozen[x] == frozen[var(r)] && x < var(r)))
+                        r = comp[i];
+                }
+                for (int i = 0; i < comp.size(); i++)
+                    seen[var(comp[i])] = 0;
+            }
+            for (int i = 0; i < comp.size(); i++)
+                repr[toInt(comp[i])] = r;
+
+            if (contra != lit_Undef)
+                break;
+        }
+    }
+
+    if (contra == lit_Undef)
+        return true;
+
+    // Both 'contra' and '~contra' imply each other, so propagating either one fails:
+    newDecisionLevel();
+    uncheckedEnqueue(contra);
+    CRef confl = propagate();
+    assert(confl != CRef_Undef);
+    if (!failedLit(contra, confl))
+        return false;
+    repr.clear();
+    return true;
+}
+
+
+// Log the clauses '(~r | l)' for the literals 'l' with the representative 'r'. A breadth-first
+// search from 'r' along the binary clauses makes each one follow from the clause of its parent in
+// the search and the binary clause between them. The numbers are stored in 'ids' and the clauses
+// in 'eqs' (pairwise), so that they can be deleted afterwards.
+void SimpSolver::proofEquivs(Lit r, const vec<Lit>& repr, vec<uint64_t>& ids, vec<Lit>& eqs)
+{
+    vec<Lit> queue, eq;
+    queue.push(r);
+    seen[var(r)] = 1;
+    for (int i = 0; i < queue.size(); i++){
+        Lit                 p  = queue[i];
+        const vec<Watcher>& ws = watches_bin[p];
+        for (int j = 0; j < ws.size(); j++){
+            Lit q = ws[j].blocker;
+            if (ca[ws[j].cref].mark() == 1 || seen[var(q)] || repr[toInt(q)] != r) continue;
+
+            seen[var(q)] = 1;
+            queue.push(q);
+            eq.clear();
+            eq.push(~r);
+            eq.push(q);
+            proof_hints.clear();
+            if (lrat()){
+                if (p != r) proof_hints.push(ids[toInt(p)]);
+                proof_hints.push(ca[ws[j].cref].id()); }
+            ids[toInt(q)] = proofAdd(eq, proof_hints);
+            eqs.push(~r);
+            eqs.push(q);
+        }
+    }
+
+    for (int i = 0; i < queue.size(); i++)
+        seen[var(queue[i])] = 0;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  substituteEquivs : ()  ->  [bool]
+|  
+|  Description:
+|    Replace each variable that is equivalent to another one, according to the binary clauses, by
+|    the representative of its class. Frozen variables are kept. The learnt clauses containing the
+|    replaced variables are removed. Returns FALSE if a conflict was found.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::substituteEquivs()
+{
+    vec<Lit> repr;
+    if (!findEquivs(repr))
+        return false;
+    else if (repr.size() == 0)
+        return true;
+
+    vec<uint64_t> ids;
+    vec<Lit>      eqs;
+    if (proof != NULL){
+        ids.growTo(repr.size(), 0);
+        for (int i = 0; i < repr.size(); i++)
+            if (repr[i] == toLit(i))
+                proofEquivs(toLit(i), repr, ids, eqs); }
+
+    // Units found on the way are propagated after all substitutions (see 'substitute()'):
+    int  substituted = 0;
+    bool res         = true;
+    for (Var v = 0; v < nVars() && res; v++){
+        Lit r = repr[toInt(mkLit(v))];
+        if (r == lit_Undef || var(r) == v || frozen[v] || value(v) != l_Undef)
+            continue;
+
+        if (value(r) != l_Undef){
+            // Assign 'v' like its representative instead (from the unit of 'r' and '(~r | v)'):
+            Lit p = value(r) == l_True ? mkLit(v) : ~mkLit(v);
+            if (proof != NULL){
+                proofUnits();
+                add_tmp.clear();
+                add_tmp.push(p);
+                proof_hints.clear();
+                if (lrat()){
+                    proof_hints.push(unit_id[var(r)]);
+                    proof_hints.push(ids[toInt(p)]); }
+                unit_id[v] = proofAdd(add_tmp, proof_hints); }
+            uncheckedEnqueue(p);
+            continue; }
+
+        uint64_t pos_id = proof != NULL ? ids[toInt(~mkLit(v))] : 0;
+        uint64_t neg_id = proof != NULL ? ids[toInt( mkLit(v))] : 0;
+        substituted++;
+        res = substitute(v, r, pos_id, neg_id);
+    }
+    res = addSubstUnits() && res;
+
+    if (proof != NULL)
+        for (int i = 0; i < eqs.size(); i += 2)
+            proof->remove(ids[toInt(eqs[i+1])], &eqs[i], 2);
+    substituted_vars += substituted;
+    if (!res)
+        return false;
+    else if (substituted > 0)
+        purgeLearnts();
+
+    return true;
+}
+
+
+//=================================================================================================
+// XOR detection:
+
+
+/*_________________________________________________________________________________________________
+|
+|  findXors : ()  ->  [void]
+|  
+|  Description:
+|    Find the XOR constraints encoded directly by the clauses: 'x1 ^ .. ^ xn = b' (with n up to
+|    'xor_max_size') is the 2^(n-1) clauses over the 'xi' with an even number of negative literals if
+|    b is one, and an odd number otherwise. The candidates for each clause are the clauses of the same
+|    size and abstraction in the occurrences of its least occurring variable. The constraints found
+|    are added to the solver (see 'Solver::addXor()'), and their variables are frozen. Clauses over
+|    variables that were frozen before only are skipped, as they were most likely found by an
+|    earlier call. The clauses are kept, so the XOR reasoning only strengthens propagation.
+|________________________________________________________________________________________________@*/
+void SimpSolver::findXors()
+{
+    vec<Lit>  xs;
+    vec<char> was_frozen(nVars());
+    for (Var v = 0; v < nVars(); v++)
+        was_frozen[v] = frozen[v];
+
+    for (int i = 0; i < clauses.size() && simp_ticks <= simp_ticks_lim; i++){
+        CRef          cr = clauses[i];
+        const Clause& c  = ca[cr];
+        int           n  = c.size();
+        if (c.mark() || n < 3 || n > xor_max_size) continue;
+
+        Var  best = var(c[0]);
+        int  neg  = 0;
+        bool done = true;
+        for (int k = 0; k < n; k++){
+            if (occurs[var(c[k])].size() < occurs[best].size())
+                best = var(c[k]);
+            neg  += sign(c[k]);
+            done &= was_frozen[var(c[k])]; }
+        if (done) continue;
+
+        // Collect the sign patterns of the clauses over the same variables, with the same parity:
+        const vec<CRef>& ds    = occurs.lookup(best);
+        uint64_t         found = 0;
+        int              count = 0;
+        bool             first = true;
+        simp_ticks += ds.size();
+        for (int j = 0; j < ds.size() && first; j++){
+            const Clause& d = ca[ds[j]];
+            if (d.mark() || d.size() != n || d.abstraction() != c.abstraction()) continue;
+
+            int pattern = 0, d_neg = 0;
+            for (int k = 0; k < n && pattern >= 0; k++){
+                int l = 0;
+                while (l < n && var(d[l]) != var(c[k])) l++;
+                if (l == n)
+                    pattern = -1;
+                else if (sign(d[l])){
+                    pattern |= 1 << k;
+                    d_neg++; }
+            }
+            if (pattern < 0 || (d_neg & 1) != (neg & 1)) continue;
+
+            // Each constraint is added once, from its first clause:
+            if (ds[j] < cr)
+                first = false;
+            if ((found >> pattern) & 1) continue;
+            found |= (uint64_t)1 << pattern;
+            count++;
+        }
+        if (!first || count < 1 << (n - 1)) continue;
+
+        bool rhs = !(neg & 1);
+        xs.clear();
+        for (int k = 0; k < n; k++)
+            xs.push(mkLit(var(c[k]), k == 0 && !rhs));
+        addXor(xs);
+        for (int k = 0; k < n; k++)
+            setFrozen(var(c[k]), true);
+        xor_constraints++;
+    }
+}
+
+
+//=================================================================================================
+// Blocked and covered clause elimination:
+
+
+/*_________________________________________________________________________________________________
+|
+|  blockedClause : (cr : CRef) (mark : vec<char>&)  ->  [bool]
+|  
+|  Description:
+|    Check if the clause 'cr' is blocked on one of its literals 'l', that is, all its resolvents on
+|    'l' are tautologies. If 'use_cce' is set, the clause is first extended by covered literal
+|    addition: when the non-tautological resolvents on a literal 'l' all contain some literals,
+|    these are added, as any model of the extended clause that falsifies the clause so far can be
+|    repaired by flipping 'l'. A blocked clause (extended or not) is removed and pushed to
+|    'elimclauses' with its blocking literal first, preceded by the intermediate clauses and their
+|    literals 'l', so that 'extendModel()' undoes the steps in reverse. Frozen and assigned literals
+|    are never used as 'l'. 'mark' maps literals (indexed by 'toInt()') to zero, and is left that way.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::blockedClause(CRef cr, vec<char>& mark)
+{
+    vec<Lit>& ext    = add_tmp;
+    int       c_sz   = ca[cr].size();
+    int       max_sz = use_cce ? c_sz + cover_lim : c_sz;
+    vec<int>  step_sizes;
+    vec<Lit>  step_lits, common;
+    Lit       block = lit_Undef;
+
+    ext.clear();
+    for (int i = 0; i < c_sz; i++){
+        Lit p = ca[cr][i];
+        ext.push(p);
+        seen[var(p)] = 1 + sign(p); }
+
+    for (int i = 0; i < ext.size() && block == lit_Undef; i++){
+        Lit l = ext[i];
+        if (frozen[var(l)] || value(l) != l_Undef)
+            continue;
+
+        const vec<CRef>& ds      = occurs.lookup(var(l));
+        bool             blocked = true;
+        simp_ticks += ds.size();
+        common.clear();
+        for (int j = 0; j < ds.size(); j++){
+            if (ds[j] == cr) continue;
+            const Clause& d     = ca[ds[j]];
+            bool          neg_l = false;
+            bool          taut  = false;
+            simp_ticks += d.size();
+            for (int k = 0; k < d.size() && !taut; k++)
+                if (d[k] == ~l)
+                    neg_l = true;
+                else
+                    taut = seen[var(d[k])] == 2 - sign(d[k]);
+            if (!neg_l || taut)
+                continue;
+
+            // A non-tautological resolvent: keep the literals it has in common with the others:
+            if (!use_cce || ext.size() >= max_sz){
+                blocked = false;
+                break;
+            }else if (blocked){
+                for (int k = 0; k < d.size(); k++)
+                    if (d[k] != ~l && seen[var(d[k])] == 0)
+                        common.push(d[k]);
+                blocked = false;
+            }else{
+                for (int k = 0; k < d.size(); k++)
+                    mark[toInt(d[k])] = 1;
+                int n = 0;
+                for (int k = 0; k < common.size(); k++)
+                    if (mark[toInt(common[k])])
+                        common[n++] = common[k];
+                common.shrink(common.size() - n);
+                for (int k = 0; k < d.size(); k++)
+                    mark[toInt(d[k])] = 0;
+            }
+            if (common.size() == 0)
+                break;
+        }
+
+        if (blocked)
+            block = l;
+        else if (common.size() > 0){
+            step_sizes.push(ext.size());
+            step_lits.push(l);
+            for (int k = 0; k < common.size() && ext.size() < max_sz; k++){
+                ext.push(common[k]);
+                seen[var(common[k])] = 1 + sign(common[k]); }
+        }
+    }
+
+    for (int i = 0; i < ext.size(); i++)
+        seen[var(ext[i])] = 0;
+
+    if (block == lit_Undef)
+        return false;
+
+    for (int i = 0; i < step_sizes.size(); i++)
+        mkElimClause(elimclauses, step_lits[i], ext, step_sizes[i]);
+    mkElimClause(elimclauses, block, ext, ext.size());
+    removeClause(cr);
+    return true;
+}
+
+
+// Remove blocked (and covered, if 'use_cce' is set) clauses until none are left, the user
+// interrupts, or 'simp_ticks_lim' is exceeded. After the first round, only the clauses with a
+// variable of a removed clause are checked again.
+void SimpSolver::eliminateBlocked()
+{
+    vec<char> dirty(nVars(), 1), next(nVars(), 0);
+    vec<char> mark(2*nVars(), 0);
+    vec<CRef> cands;
+    int       removed = 1;
+
+    while (removed > 0 && simp_ticks <= simp_ticks_lim && !asynch_interrupt){
+        cands.clear();
+        for (int i = 0; i < clauses.size(); i++){
+            const Clause& c = ca[clauses[i]];
+            if (c.mark()) continue;
+            for (int j = 0; j < c.size(); j++)
+                if (dirty[var(c[j])]){
+                    cands.push(clauses[i]);
+                    break; }
+        }
+
+        removed = 0;
+        for (int i = 0; i < cands.size() && simp_ticks <= simp_ticks_lim && !asynch_interrupt; i++)
+            if (!ca[cands[i]].mark() && blockedClause(cands[i], mark)){
+                const Clause& c = ca[cands[i]];
+                for (int j = 0; j < c.size(); j++)
+                    next[var(c[j])] = 1;
+                removed++; }
+
+        blocked_clauses += removed;
+        for (int i = 0; i < nVars(); i++){
+            dirty[i] = next[i];
+            next[i]  = 0; }
+        checkGarbage(simp_garbage_frac);
+    }
+}
+
+
+//=================================================================================================
+// Bounded variable addition:
+
+
+/*_________________________________________________________________________________________________
+|
+|  bvaLit : (l : Lit) (queue : Heap<Lit,BvaLt,MkIndexLit>&) (count : vec<int>&) (found : vec<char>&)
+|           ->  [bool]
+|  
+|  Description:
+|    Look for literals 'l1'..'lm' (with 'l1 == l') and clauses 'C1'..'Cn' such that all the clauses
+|    '(li | Cj)' exist. If 'm*n > m+n', they are replaced by the clauses '(~x | li)' and '(x | Cj)'
+|    for a new variable 'x', whose resolvents are exactly the replaced clauses. The candidates for
+|    the other literals are found once, after which they are added greedily. The literals whose
+|    number of occurrences changed are updated in 'queue'. 'count' and 'found' map all literals
+|    (indexed by 'toInt()') to zero, and are left that way. Returns FALSE if a conflict was found.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::bvaLit(Lit l, Heap<Lit,BvaLt,MkIndexLit>& queue, vec<int>& count, vec<char>& found)
+{
+    // The clauses containing 'l', skipping those with assigned literals:
+    vec<CRef> cls;
+    const vec<CRef>& occ = occurs.lookup(var(l));
+    simp_ticks += occ.size();
+    for (int i = 0; i < occ.size(); i++){
+        const Clause& c    = ca[occ[i]];
+        bool          keep = find(c, l);
+        for (int j = 0; j < c.size() && keep; j++)
+            keep = value(c[j]) == l_Undef;
+        if (keep) cls.push(occ[i]);
+    }
+    if (cls.size() < 2)
+        return true;
+
+    // Find the clauses equal to one of 'cls' with 'l' replaced by another literal, scanning the
+    // occurrences of the least frequent of its other literals:
+    vec<BvaMatch> matches;
+    for (int i = 0; i < cls.size(); i++){
+        const Clause& c     = ca[cls[i]];
+        Lit           least = lit_Undef;
+        for (int j = 0; j < c.size(); j++)
+            if (c[j] != l){
+                seen[var(c[j])] = 1 + sign(c[j]);
+                if (least == lit_Undef || n_occ[c[j]] < n_occ[least])
+                    least = c[j]; }
+
+        const vec<CRef>& ds    = occurs.lookup(var(least));
+        int              first = matches.size();
+        simp_ticks += ds.size();
+        for (int j = 0; j < ds.size(); j++){
+            const Clause& d = ca[ds[j]];
+            if (d.size() != c.size() || ds[j] == cls[i])
+                continue;
+
+            Lit other = lit_Undef;
+            int k;
+            for (k = 0; k < d.size(); k++)
+                if (value(d[k]) != l_Undef)
+                    break;
+                else if (seen[var(d[k])] != 1 + sign(d[k])){
+                    if (other != lit_Undef) break;
+                    other = d[k]; }
+            simp_ticks += k;
+
+            if (k == d.size() && other != lit_Undef && var(other) != var(l) && seen[var(other)] == 0 && !found[toInt(other)]){
+                found[toInt(other)] = 1;
+                matches.push(BvaMatch(other, i, ds[j])); }
+        }
+
+        for (int j = first; j < matches.size(); j++)
+            found[toInt(matches[j].lit)] = 0;
+        for (int j = 0; j < c.size(); j++)
+            seen[var(c[j])] = 0;
+    }
+
+    // Add the literal completing the most of the remaining clauses (marked in 'alive') as long as
+    // that increases the reduction. The chosen literals are marked in 'found':
+    vec<Lit>  lits, touched_lits;
+    vec<char> alive(cls.size(), 1);
+    int       n = cls.size();
+    lits.push(l);
+    for (;;){
+        Lit best = lit_Undef;
+        for (int i = 0; i < matches.size(); i++){
+            Lit p = matches[i].lit;
+            if (!alive[matches[i].cls] || found[toInt(p)])
+                continue;
+            if (count[toInt(p)]++ == 0)
+                touched_lits.push(p);
+            if (best == lit_Undef || count[toInt(p)] > count[toInt(best)])
+                best = p;
+        }
+        simp_ticks += matches.size();
+
+        int m      = lits.size();
+        int n_best = best == lit_Undef ? 0 : count[toInt(best)];
+        for (int i = 0; i < touched_lits.size(); i++)
+            count[toInt(touched_lits[i])] = 0;
+        touched_lits.clear();
+
+        if (best == lit_Undef || (m+1)*n_best - (m+1) - n_best <= m*n - m - n)
+            break;
+
+        for (int i = 0; i < matches.size(); i++)
+            if (matches[i].lit == best && alive[matches[i].cls])
+                alive[matches[i].cls] = 2;
+        for (int i = 0; i < alive.size(); i++)
+            alive[i] = alive[i] == 2;
+        found[toInt(best)] = 1;
+        lits.push(best);
+        n = n_best;
+    }
+
+    int m = lits.size();
+    if (m*n - m - n > 0 && !bvaReplace(l, lits, found, cls, alive, matches, queue))
+        return false;
+
+    for (int i = 1; i < m; i++)
+        found[toInt(lits[i])] = 0;
+    count.growTo(2*nVars(), 0);
+    found.growTo(2*nVars(), 0);
+
+    return true;
+}
+
+
+// Replace the clauses '(li | Cj)' found by 'bvaLit()', where 'lits' holds the literals 'li' (marked
+// in 'found') and 'alive' marks the clauses of 'cls' that are '(l | Cj)', by '(~x | li)' and '(x | Cj)'
+// for a new variable 'x'. Returns FALSE if a conflict was found.
+bool SimpSolver::bvaReplace(Lit l, const vec<Lit>& lits, const vec<char>& found, const vec<CRef>& cls,
+                            const vec<char>& alive, const vec<BvaMatch>& matches, Heap<Lit,BvaLt,MkIndexLit>& queue)
+{
+    Var x = newVar();
+    bva_vars++;
+
+    // Each new clause is a RAT on its first literal: no clause contains 'x' while the clauses
+    // '(~x | li)' are added, and the resolvents of '(x | Cj)' on 'x' are the replaced clauses:
+    vec<Lit> ps;
+    proof_hints.clear();
+    for (int i = 0; i < lits.size(); i++){
+        ps.clear();
+        ps.push(~mkLit(x));
+        ps.push(lits[i]);
+        if (proof != NULL)
+            add_id = proofAdd(ps, proof_hints);
+        if (!addClause_(ps))
+            return false;
+    }
+    for (int i = 0; i < cls.size(); i++)
+        if (alive[i]){
+            ps.clear();
+            ps.push(mkLit(x));
+            const Clause& c = ca[cls[i]];
+            for (int j = 0; j < c.size(); j++)
+                if (c[j] != l)
+                    ps.push(c[j]);
+            if (proof != NULL)
+                add_id = proofAdd(ps, proof_hints);
+            if (!addClause_(ps))
+                return false;
+        }
+
+    // NOTE: identical clauses may be found more than once.
+    for (int i = 0; i < cls.size(); i++)
+        if (alive[i] && !ca[cls[i]].mark())
+            removeClause(cls[i]);
+    for (int i = 0; i < matches.size(); i++)
+        if (alive[matches[i].cls] && found[toInt(matches[i].lit)] && !ca[matches[i].cr].mark())
+            removeClause(matches[i].cr);
+
+    for (int i = 0; i < cls.size(); i++)
+        if (alive[i]){
+            const Clause& c = ca[cls[i]];
+            for (int j = 0; j < c.size(); j++)
+                if (queue.inHeap(c[j]))
+                    queue.update(c[j]);
+        }
+    for (int i = 1; i < lits.size(); i++)
+        if (queue.inHeap(lits[i]))
+            queue.update(lits[i]);
+    queue.update(l);
+    queue.update(mkLit(x));
+    queue.update(~mkLit(x));
+
+    return true;
+}
+
+
+// Apply 'bvaLit()' to the literals in the order of their number of occurrences. Returns FALSE if
+// a conflict was found.
+bool SimpSolver::addVariables()
+{
+    // Variable addition is logged with RAT steps, which the LRAT proofs written here cannot express:
+    if (lrat())
+        return true;
+
+    Heap<Lit,BvaLt,MkIndexLit> queue((BvaLt(n_occ)));
+    vec<int>                   count(2*nVars(), 0);
+    vec<char>                  found(2*nVars(), 0);
+    for (Var v = 0; v < nVars(); v++)
+        if (!isEliminated(v) && value(v) == l_Undef){
+            if (n_occ[ mkLit(v)] > 1) queue.insert( mkLit(v));
+            if (n_occ[~mkLit(v)] > 1) queue.insert(~mkLit(v)); }
+
+    while (!queue.empty() && simp_ticks <= simp_ticks_lim && !asynch_interrupt){
+        Lit l = queue.removeMin();
+        if (n_occ[l] > 1 && value(l) == l_Undef && !bvaLit(l, queue, count, found))
+            return false;
+        checkGarbage(simp_garbage_frac);
+    }
+
+    return true;
+}
+
+
+//=================================================================================================
+// Inprocessing:
+
+
+bool SimpSolver::inprocessSimp(uint64_t ticks)
+{
+    if (!use_simplification)
+        return true;
+
+    // Assumptions must be temporarily frozen, as in 'solve_()':
+    vec<Var> extra_frozen;
+    for (int i = 0; i < assumptions.size(); i++){
+        Var v = var(assumptions[i]);
+        if (!frozen[v]){
+            frozen[v] = true;
+            extra_frozen.push(v); } }
+
+    int elim_vars  = eliminated_vars;
+    simp_ticks_lim = simp_ticks + ticks;
+    bool result    = (!use_equiv || substituteEquivs()) && checkLearnts() && eliminateTouched();
+    simp_ticks_lim = UINT64_MAX;
+
+    if (result && eliminated_vars > elim_vars)
+        purgeLearnts();
+    checkGarbage();
+
+    for (int i = 0; i < extra_frozen.size(); i++)
+        setFrozen(extra_frozen[i], false);
+
+    return ok = result;
+}
+
+
+// Check the learnt clauses added since the previous round against the problem clauses. A learnt
+// clause that subsumes or strengthens a problem clause becomes a problem clause itself, after which
+// 'backwardSubsumptionCheck()' does the rest.
+bool SimpSolver::checkLearnts()
+{
+    int i, j;
+    for (i = j = 0; i < learnts.size(); i++){
+        CRef    cr = learnts[i];
+        Clause& c  = ca[cr];
+        if (c.checked() || simp_ticks > simp_ticks_lim || satisfied(c)){
+            learnts[j++] = cr;
+            continue; }
+        c.checked(true);
+
+        // Look for a problem clause containing all literals of 'c', or all but one negated, among the
+        // occurrences of its least occurring variable:
+        Var best = var(c[0]);
+        for (int k = 0; k < c.size(); k++){
+            if (occurs.lookup(var(c[k])).size() < occurs[best].size())
+                best = var(c[k]);
+            seen[var(c[k])] = 1 + sign(c[k]); }
+
+        const vec<CRef>& cs = occurs[best];
+        bool promote = false;
+        simp_ticks += cs.size();
+        for (int k = 0; k < cs.size() && !promote; k++){
+            const Clause& d = ca[cs[k]];
+            if (d.mark() || d.size() < c.size()) continue;
+            int same = 0, flipped = 0;
+            for (int l = 0; l < d.size(); l++)
+                if (seen[var(d[l])] == 1 + sign(d[l]))
+                    same++;
+                else if (seen[var(d[l])] != 0)
+                    flipped++;
+            promote = same == c.size() || (same == c.size() - 1 && flipped == 1);
+        }
+
+        for (int k = 0; k < c.size(); k++)
+            seen[var(c[k])] = 0;
+
+        if (!promote){
+            learnts[j++] = cr;
+            continue; }
+
+        add_tmp.clear();
+        for (int k = 0; k < c.size(); k++)
+            add_tmp.push(c[k]);
+        if (proof != NULL){
+            proofUnits();
+            proof_hints.clear();
+            if (lrat()) proof_hints.push(c.id());
+            add_id = proofAdd(add_tmp, proof_hints); }
+        Solver::removeClause(cr);
+        promoted_learnts++;
+        if (!addClause_(add_tmp)){
+            for (i++; i < learnts.size(); i++)
+                learnts[j++] = learnts[i];
+            learnts.shrink(i - j);
+            return false; }
+    }
+    learnts.shrink(i - j);
+    countKept();
+
+    return true;
+}
+
+
+// Remove the learnt clauses that contain eliminated variables:
+void SimpSolver::purgeLearnts()
+{
+    int i, j;
+    for (i = j = 0; i < learnts.size(); i++){
+        const Clause& c = ca[learnts[i]];
+        bool elim = false;
+        for (int k = 0; k < c.size() && !elim; k++)
+            elim = isEliminated(var(c[k]));
+        if (elim)
+            Solver::removeClause(learnts[i]);
+        else
+            learnts[j++] = learnts[i];
+    }
+    learnts.shrink(i - j);
+    countKept();
+}
+
+
 //=================================================================================================
 // Garbage Collection methods:
 
@@ -716,6 +2137,7 @@ void SimpSolver::garbageCollect()
     ClauseAllocator to(ca.size() - ca.wasted()); 
 
     to.extra_clause_field = ca.extra_clause_field; // NOTE: this is important to keep (or lose) the extra fields.
+    to.clause_ids         = ca.clause_ids;
     relocAll(to);
     Solver::relocAll(to);
     if (verbosity >= 2)
@@ -41,6 +41,7 @@ class SimpSolver : public Solver {
     //
     Var     newVar    (lbool upol = l_Undef, bool dvar = true);
     void    releaseVar(Lit l);
+    void    reserve   (int n_vars, int n_clauses, uint64_t n_lits);
     bool    addClause (const vec<Lit>& ps);
     bool    addEmptyClause();                // Add the empty clause to the solver.
     bool    addClause (Lit p);               // Add a unit clause to the solver.
@@ -48,6 +49,11 @@ class SimpSolver : public Solver {
     bool    addClause (Lit p, Lit q, Lit r); // Add a ternary clause to the solver.
     bool    addClause (Lit p, Lit q, Lit r, Lit s); // Add a quaternary clause to the solver. 
     bool    addClause_(      vec<Lit>& ps);
+    bool    addAtMost (const vec<Lit>& ps, int k);   // Add the constraint that at most 'k' of 'ps' are true.
+    bool    addAtLeast(const vec<Lit>& ps, int k);   // Add the constraint that at least 'k' of 'ps' are true.
+    bool    addAtLeast_(     vec<Lit>& ps, int k);   // The variables of cardinality constraints are frozen.
+    bool    addLinear (const vec<Lit>& ps, const vec<int64_t>& cs, int64_t k);
+    bool    addLinear_(      vec<Lit>& ps,       vec<int64_t>& cs, int64_t k); // The variables of linear constraints are frozen.
     bool    substitute(Var v, Lit x);  // Replace all occurences of v with x (may cause a contradiction).
 
     // Variable mode:
@@ -92,10 +98,17 @@ class SimpSolver : public Solver {
                                // -1 means no limit.
     int     subsumption_lim;   // Do not check if subsumption against a clause larger than this. -1 means no limit.
     double  simp_garbage_frac; // A different limit for when to issue a GC during simplification (Also see 'garbage_frac').
+    int     elim_threads;      // Threads used for variable elimination (0 = one per hardware thread).
 
     bool    use_asymm;         // Shrink clauses by asymmetric branching.
     bool    use_rcheck;        // Check if a clause is already implied. Prett costly, and subsumes subsumptions :)
     bool    use_elim;          // Perform variable elimination.
+    bool    use_equiv;         // Substitute equivalent literals found in the binary clauses.
+    bool    use_gates;         // Only produce the necessary resolvents when eliminating variables defined by gates.
+    bool    use_bce;           // Eliminate blocked clauses.
+    bool    use_cce;           // Eliminate covered clauses (implies 'use_bce').
+    bool    use_bva;           // Add variables that replace a product of clauses by a sum (bounded variable addition).
+    bool    use_gauss;         // Detect XOR constraints in the clauses and propagate them by Gauss-Jordan elimination.
     bool    extend_model;      // Flag to indicate whether the user needs to look at the full model.
 
     // Statistics:
@@ -103,6 +116,12 @@ class SimpSolver : public Solver {
     int     merges;
     int     asymm_lits;
     int     eliminated_vars;
+    int     promoted_learnts;
+    int     substituted_vars;
+    int     gate_vars;
+    int     bva_vars;
+    int     blocked_clauses;
+    int     xor_constraints;
 
  protected:
 
@@ -124,6 +143,42 @@ class SimpSolver : public Solver {
         //     return c_x < c_y || c_x == c_y && x < y; }
     };
 
+    // A variable elimination, computed separately from its application to the clauses so that
+    // variables with disjoint occurrences can be handled by several threads:
+    struct ElimJob {
+        Var       v;
+        vec<CRef> pos, neg;      // The positive and negative occurrences (gate clauses first).
+        int       pos_g, neg_g;  // The number of gate clauses in 'pos' and 'neg'.
+        int       size;          // The total size of the occurrences, to detect changes before applying.
+        bool      elim;          // Whether the resolvents are within the limits.
+        vec<Lit>  resolvents;    // Each resolvent is terminated by 'lit_Undef'.
+        vec<int>  sources;       // The indices in 'pos' and 'neg' of the clauses of each resolvent.
+        uint64_t  ticks;
+        int       merges;
+    };
+
+    enum { elim_batch = 1024 };  // The number of variables selected at a time for parallel elimination.
+
+    enum { cover_lim = 32 };     // The number of literals covered clause elimination may add to a clause.
+
+    enum { xor_max_size = 6 };   // The largest XOR constraints detected (they take 2^(n-1) clauses).
+
+    // Bounded variable addition processes the literals with the most occurrences first:
+    struct BvaLt {
+        const LMap<int>& n_occ;
+        explicit BvaLt(const LMap<int>& no) : n_occ(no) {}
+        bool operator()(Lit x, Lit y) const { return n_occ[x] > n_occ[y]; }
+    };
+
+    // A clause equal to clause 'cls' of the ones considered by 'bvaLit()', with 'lit' in place of the
+    // literal being factored out:
+    struct BvaMatch {
+        Lit  lit;
+        int  cls;
+        CRef cr;
+        BvaMatch(Lit l, int i, CRef c) : lit(l), cls(i), cr(c) {}
+    };
+
     struct ClauseDeleted {
         const ClauseAllocator& ca;
         explicit ClauseDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
@@ -146,6 +201,11 @@ class SimpSolver : public Solver {
     VMap<char>          eliminated;
     int                 bwdsub_assigns;
     int                 n_touched;
+    uint64_t            simp_ticks;          // Work done by subsumption and elimination (occurrences visited).
+    uint64_t            simp_ticks_lim;      // Stop when 'simp_ticks' exceeds this (only limited when inprocessing).
+    vec<ElimJob*>       elim_jobs;           // The jobs of 'eliminateBatches()' (kept between calls).
+    vec<Lit>            subst_units;         // Clauses 'substitute()' reduced to units, each terminated by 'lit_Undef'..
+    vec<uint64_t>       subst_unit_ids;      // .. and their proof numbers.
 
     // Temporaries:
     //
@@ -158,14 +218,41 @@ class SimpSolver : public Solver {
     bool          asymmVar                 (Var v);
     void          updateElimHeap           (Var v);
     void          gatherTouchedClauses     ();
-    bool          merge                    (const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause);
-    bool          merge                    (const Clause& _ps, const Clause& _qs, Var v, int& size);
+    static bool   merge                    (const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause);
+    static bool   merge                    (const Clause& _ps, const Clause& _qs, Var v, int& size);
     bool          backwardSubsumptionCheck (bool verbose = false);
+    CRef          findClause               (const vec<CRef>& cs, const vec<Lit>& lits, uint64_t& ticks);
+    bool          andGate                  (Lit l, const vec<CRef>& ls, const vec<CRef>& nls, vec<CRef>& gate_l, vec<CRef>& gate_nl, uint64_t& ticks);
+    bool          iteGate                  (Lit l, const vec<CRef>& ls, const vec<CRef>& nls, vec<CRef>& gate_l, vec<CRef>& gate_nl, uint64_t& ticks);
+    bool          xorGate                  (Var v, const vec<CRef>& pos, const vec<CRef>& neg, vec<CRef>& gate_pos, vec<CRef>& gate_neg, uint64_t& ticks);
+    void          findGate                 (ElimJob& job);
+    void          elimOccurs               (Var v, ElimJob& job);
+    void          elimResolve              (ElimJob& job);
+    void          elimResolveJobs          (int n_jobs, int first, int step);
+    bool          elimChanged              (const ElimJob& job);
+    bool          elimApply                (ElimJob& job);
     bool          eliminateVar             (Var v);
+    bool          eliminateBatches         (int n_threads);
+    bool          eliminateTouched         ();
+    bool          substitute               (Var v, Lit x, uint64_t pos_id, uint64_t neg_id);
+    bool          addSubstUnits            ();
+    bool          findEquivs               (vec<Lit>& repr);
+    void          proofEquivs              (Lit r, const vec<Lit>& repr, vec<uint64_t>& ids, vec<Lit>& eqs);
+    bool          substituteEquivs         ();
+    bool          blockedClause            (CRef cr, vec<char>& mark);
+    void          eliminateBlocked         ();
+    void          findXors                 ();
+    bool          bvaLit                   (Lit l, Heap<Lit,BvaLt,MkIndexLit>& queue, vec<int>& count, vec<char>& found);
+    bool          bvaReplace               (Lit l, const vec<Lit>& lits, const vec<char>& found, const vec<CRef>& cls,
+                                            const vec<char>& alive, const vec<BvaMatch>& matches, Heap<Lit,BvaLt,MkIndexLit>& queue);
+    bool          addVariables             ();
     void          extendModel              ();
+    bool          inprocessSimp            (uint64_t ticks);
+    bool          checkLearnts             ();
+    void          purgeLearnts             ();
 
-    void          removeClause             (CRef cr);
-    bool          strengthenClause         (CRef cr, Lit l);
+    void          removeClause             (CRef cr, bool proof_del = true);
+    bool          strengthenClause         (CRef cr, Lit l);  // (LRAT hints for the result are taken from 'proof_hints')
     bool          implied                  (const vec<Lit>& c);
     void          relocAll                 (ClauseAllocator& to);
 };
@@ -183,12 +270,32 @@ inline void SimpSolver::updateElimHeap(Var v) {
         elim_heap.update(v); }
 
 
+inline bool SimpSolver::substitute   (Var v, Lit x)         { bool res = substitute(v, x, 0, 0); return addSubstUnits() && res; }
+
 inline bool SimpSolver::addClause    (const vec<Lit>& ps)    { ps.copyTo(add_tmp); return addClause_(add_tmp); }
 inline bool SimpSolver::addEmptyClause()                     { add_tmp.clear(); return addClause_(add_tmp); }
 inline bool SimpSolver::addClause    (Lit p)                 { add_tmp.clear(); add_tmp.push(p); return addClause_(add_tmp); }
 inline bool SimpSolver::addClause    (Lit p, Lit q)          { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp); }
 inline bool SimpSolver::addClause    (Lit p, Lit q, Lit r)   { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); return addClause_(add_tmp); }
 inline bool SimpSolver::addClause    (Lit p, Lit q, Lit r, Lit s){ add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); add_tmp.push(s); return addClause_(add_tmp); }
+inline bool SimpSolver::addAtLeast   (const vec<Lit>& ps, int k){ ps.copyTo(add_tmp); return addAtLeast_(add_tmp, k); }
+inline bool SimpSolver::addAtMost    (const vec<Lit>& ps, int k){
+    add_tmp.clear();
+    for (int i = 0; i < ps.size(); i++)
+        add_tmp.push(~ps[i]);
+    return addAtLeast_(add_tmp, ps.size() - k); }
+inline bool SimpSolver::addAtLeast_  (vec<Lit>& ps, int k){
+    for (int i = 0; i < ps.size(); i++){
+        assert(!isEliminated(var(ps[i])));
+        setFrozen(var(ps[i]), true); }
+    return Solver::addAtLeast_(ps, k); }
+inline bool SimpSolver::addLinear    (const vec<Lit>& ps, const vec<int64_t>& cs, int64_t k){
+    ps.copyTo(add_tmp); cs.copyTo(coef_tmp); return addLinear_(add_tmp, coef_tmp, k); }
+inline bool SimpSolver::addLinear_   (vec<Lit>& ps, vec<int64_t>& cs, int64_t k){
+    for (int i = 0; i < ps.size(); i++){
+        assert(!isEliminated(var(ps[i])));
+        setFrozen(var(ps[i]), true); }
+    return Solver::addLinear_(ps, cs, k); }
 inline void SimpSolver::setFrozen    (Var v, bool b) { frozen[v] = (char)b; if (use_simplification && !b) { updateElimHeap(v); } }
 
 inline void SimpSolver::freezeVar(Var v){
@@ -0,0 +1,90 @@
+/***********************************************************************************[ParseUtils.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "minisat/utils/ParseUtils.h"
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace Minisat;
+
+//=================================================================================================
+// MappedFile:
+
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+
+bool MappedFile::open(const char* file)
+{
+    close();
+
+    int fd = ::open(file, O_RDONLY);
+    if (fd == -1) return false;
+
+    // Only plain, non-empty, uncompressed files are mapped:
+    struct stat st;
+    unsigned char magic[2];
+    if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size == 0
+     || (st.st_size >= 2 && pread(fd, magic, 2, 0) == 2 && magic[0] == 0x1f && magic[1] == 0x8b)){
+        ::close(fd);
+        return false; }
+
+    // Reserve an anonymous (zero filled) range with room for at least one byte past the end of
+    // the file, and map the file on top of it. The remaining bytes of the last file page are
+    // zero filled by the kernel, so the text is always '\0'-terminated:
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size    = (size_t)st.st_size;
+    mapped  = (size / page + 1) * page;
+    void* r = mmap(NULL, mapped, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (r != MAP_FAILED && mmap(r, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED){
+        munmap(r, mapped);
+        r = MAP_FAILED; }
+    ::close(fd);
+
+    if (r == MAP_FAILED){
+        size = mapped = 0;
+        return false; }
+
+#if defined(MADV_SEQUENTIAL)
+    madvise(r, size, MADV_SEQUENTIAL);
+#endif
+    data = (char*)r;
+    return true;
+}
+
+
+void MappedFile::close()
+{
+    if (data != NULL)
+        munmap(data, mapped);
+    data   = NULL;
+    size   = mapped = 0;
+}
+
+#else
+
+bool MappedFile::open (const char* /*file*/) { return false; }
+void MappedFile::close()                     { }
+
+#endif
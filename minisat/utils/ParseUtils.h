@@ -21,11 +21,13 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef Minisat_ParseUtils_h
 #define Minisat_ParseUtils_h
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
 
 #include <zlib.h>
 
+#include "minisat/mtl/IntTypes.h"
 #include "minisat/mtl/XAlloc.h"
 
 namespace Minisat {
@@ -61,6 +63,36 @@ public:
 };
 
 
+//-------------------------------------------------------------------------------------------------
+// A read-only memory mapping of an uncompressed file:
+//
+// The mapped text is always followed by at least one '\0' byte, so it can be parsed directly
+// through a 'const char*' without checking for the end of the mapping on every character.
+
+
+class MappedFile {
+    char*  data;
+    size_t size;    // Size of the file in bytes.
+    size_t mapped;  // Size of the reserved address range (always larger than 'size').
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+public:
+    MappedFile() : data(NULL), size(0), mapped(0) {}
+    ~MappedFile() { close(); }
+
+    // Fails for files that are not regular, are empty, or are gzip compressed (and on platforms
+    // without 'mmap()'). The caller is then expected to fall back to a 'StreamBuffer'.
+    bool        open  (const char* file);
+    void        close ();
+
+    bool        isOpen() const { return data != NULL; }
+    const char* begin () const { return data; }
+    size_t      bytes () const { return size; }
+};
+
+
 //-------------------------------------------------------------------------------------------------
 // End-of-file detection functions for StreamBuffer and char*:
 
@@ -100,6 +132,20 @@ static int parseInt(B& in) {
     return neg ? -val : val; }
 
 
+template<class B>
+static int64_t parseInt64(B& in) {
+    int64_t val = 0;
+    bool    neg = false;
+    skipWhitespace(in);
+    if      (*in == '-') neg = true, ++in;
+    else if (*in == '+') ++in;
+    if (*in < '0' || *in > '9') fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+    while (*in >= '0' && *in <= '9')
+        val = val*10 + (*in - '0'),
+        ++in;
+    return neg ? -val : val; }
+
+
 // String matching: in case of a match the input iterator will be advanced the corresponding
 // number of characters.
 template<class B>
@@ -0,0 +1,212 @@
+/****************************************************************************************[Check.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <zlib.h>
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/utils/ParseUtils.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Checks the result file written by the solvers against a DIMACS problem (used by the regression
+// tests): a model must satisfy every clause, and an LRAT proof of unsatisfiability (in textual
+// format) must derive the empty clause. Only unit propagation steps are accepted in the proof,
+// which is all the solvers write in LRAT mode.
+
+
+static vec<int>         lits;       // The literals of all clauses, each clause terminated by 0.
+static vec<int>         start;      // Where clause 'i' starts in 'lits' (-1 if there is no clause 'i').
+static vec<signed char> value;      // The value of each variable: 1 (true), -1 (false) or 0.
+static vec<int>         trail;      // The assigned variables.
+
+static int litValue(int l) {
+    int v = abs(l);
+    return v >= value.size() ? 0 : l > 0 ? value[v] : -value[v]; }
+
+static void assign(int l) {
+    int v = abs(l);
+    value.growTo(v + 1, 0);
+    value[v] = l > 0 ? 1 : -1;
+    trail.push(v); }
+
+static void undoAll() {
+    for (int i = 0; i < trail.size(); i++)
+        value[trail[i]] = 0;
+    trail.clear(); }
+
+static void addClause(int64_t id, const vec<int>& c) {
+    if (id <= 0 || id > INT32_MAX - 1)
+        printf("ERROR! Clause number out of range: %" PRId64 "\n", id), exit(1);
+    int i = (int)id;
+    start.growTo(i + 1, -1);
+    if (start[i] != -1)
+        printf("ERROR! Clause number given twice: %d\n", i), exit(1);
+    start[i] = lits.size();
+    for (int j = 0; j < c.size(); j++)
+        lits.push(c[j]);
+    lits.push(0); }
+
+// Reads integers up to (and not including) the terminating 0:
+template<class B>
+static void readList(B& in, vec<int>& xs) {
+    xs.clear();
+    for (int x; (x = parseInt(in)) != 0;)
+        xs.push(x); }
+
+
+//=================================================================================================
+// Checking models and proofs:
+
+
+static void readProblem(const char* file) {
+    gzFile f = gzopen(file, "rb");
+    if (f == NULL)
+        printf("ERROR! Could not open file: %s\n", file), exit(1);
+    StreamBuffer in(f);
+    vec<int>     c;
+    int64_t      n = 0;
+    for (;;){
+        skipWhitespace(in);
+        if (isEof(in)) break;
+        if (*in == 'c' || *in == 'p')
+            skipLine(in);
+        else{
+            readList(in, c);
+            addClause(++n, c); }
+    }
+    gzclose(f); }
+
+
+template<class B>
+static void checkModel(B& in) {
+    vec<int> model;
+    readList(in, model);
+    for (int i = 0; i < model.size(); i++)
+        assign(model[i]);
+
+    for (int i = 1; i < start.size(); i++){
+        int j = start[i];
+        while (lits[j] != 0 && litValue(lits[j]) != 1) j++;
+        if (lits[j] == 0)
+            printf("ERROR! Clause %d is not satisfied by the model\n", i), exit(1);
+    }
+}
+
+
+// Checks that the hints of a proof line derive 'c' by unit propagation:
+static void checkStep(int64_t id, const vec<int>& c, const vec<int>& hints) {
+    for (int i = 0; i < c.size(); i++)
+        if (litValue(c[i]) == 0)
+            assign(-c[i]);
+        else if (litValue(c[i]) == 1){
+            undoAll();          // (a tautology)
+            return; }
+
+    for (int i = 0; i < hints.size(); i++){
+        int h = hints[i];
+        if (h < 0)
+            printf("ERROR! RAT step not supported in clause %" PRId64 "\n", id), exit(1);
+        if (h >= start.size() || start[h] == -1)
+            printf("ERROR! Clause %" PRId64 " uses the missing clause %d\n", id, h), exit(1);
+
+        int unit = 0, n_undef = 0;
+        for (int j = start[h]; lits[j] != 0; j++)
+            if (litValue(lits[j]) == 1)
+                printf("ERROR! Clause %" PRId64 " uses the satisfied clause %d\n", id, h), exit(1);
+            else if (litValue(lits[j]) == 0 && lits[j] != unit)
+                unit = lits[j], n_undef++;
+
+        if (n_undef == 0){
+            undoAll();
+            return; }
+        else if (n_undef > 1)
+            printf("ERROR! Clause %" PRId64 " uses the non-unit clause %d\n", id, h), exit(1);
+        assign(unit);
+    }
+    printf("ERROR! The hints of clause %" PRId64 " give no conflict\n", id), exit(1);
+}
+
+
+static void checkProof(const char* file) {
+    gzFile f = gzopen(file, "rb");
+    if (f == NULL)
+        printf("ERROR! Could not open file: %s\n", file), exit(1);
+    StreamBuffer in(f);
+    vec<int>     c, hints;
+    for (;;){
+        skipWhitespace(in);
+        if (isEof(in)) break;
+
+        int64_t id = parseInt64(in);
+        skipWhitespace(in);
+        if (*in == 'd'){
+            ++in;
+            readList(in, hints);
+            for (int i = 0; i < hints.size(); i++)
+                if (hints[i] > 0 && hints[i] < start.size())
+                    start[hints[i]] = -1;
+        }else{
+            readList(in, c);
+            readList(in, hints);
+            checkStep(id, c, hints);
+            addClause(id, c);
+            if (c.size() == 0){
+                gzclose(f);
+                return; }
+        }
+    }
+    printf("ERROR! The proof does not derive the empty clause\n"), exit(1);
+}
+
+
+//=================================================================================================
+// Main:
+
+
+int main(int argc, char** argv)
+{
+    if (argc < 3 || argc > 4)
+        printf("USAGE: %s <input-file> <result-file> [<lrat-proof-file>]\n", argv[0]), exit(1);
+
+    readProblem(argv[1]);
+
+    gzFile f = gzopen(argv[2], "rb");
+    if (f == NULL)
+        printf("ERROR! Could not open file: %s\n", argv[2]), exit(1);
+    StreamBuffer in(f);
+    bool sat = *in == 'S';
+    if (!eagerMatch(in, sat ? "SAT" : "UNSAT"))
+        printf("ERROR! No result in file: %s\n", argv[2]), exit(1);
+
+    if (sat){
+        checkModel(in);
+        printf("SAT (model checked)\n");
+    }else if (argc == 4){
+        checkProof(argv[3]);
+        printf("UNSAT (proof checked)\n");
+    }else
+        printf("UNSAT\n");
+    gzclose(f);
+
+    return 0;
+}
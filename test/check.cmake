@@ -0,0 +1,26 @@
+# Runs a solver on a DIMACS problem and checks its result with 'minisat_check' (see
+# 'add_checked_test()' in CMakeLists.txt). Expects the variables SOLVER, CHECKER, INPUT, OUTPUT (the
+# path prefix of the result and proof files), EXPECT (SAT or UNSAT), ARGS (the solver options), and
+# PROOF (whether to write and check an LRAT proof).
+
+set(args -verb=0 ${ARGS})
+if (PROOF)
+  set(proof ${OUTPUT}.lrat)
+  list(APPEND args -lrat -no-proof-binary -proof=${proof})
+endif()
+
+file(REMOVE ${OUTPUT}.out)
+execute_process(COMMAND ${SOLVER} ${args} ${INPUT} ${OUTPUT}.out)
+if (NOT EXISTS ${OUTPUT}.out)
+  message(FATAL_ERROR "No result written by: ${SOLVER} ${args} ${INPUT}")
+endif()
+
+file(STRINGS ${OUTPUT}.out result LIMIT_COUNT 1)
+if (NOT result STREQUAL EXPECT)
+  message(FATAL_ERROR "Expected ${EXPECT}, but the result is ${result}")
+endif()
+
+execute_process(COMMAND ${CHECKER} ${INPUT} ${OUTPUT}.out ${proof} RESULT_VARIABLE status)
+if (NOT status EQUAL 0)
+  message(FATAL_ERROR "The result does not check")
+endif()